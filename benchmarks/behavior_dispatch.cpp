@@ -0,0 +1,115 @@
+// Compares trying each handler in turn with looking up the handler in the
+// dispatch table for a behavior with 32 handlers. Each scenario sends messages
+// that match the first, the middle or the last handler of the behavior.
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/behavior_impl.hpp"
+#include "caf/exec_main.hpp"
+#include "caf/message.hpp"
+#include "caf/type_id.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+      .add(iterations, "iterations,i", "number of messages per scenario");
+  }
+  size_t iterations = 10'000'000;
+};
+
+// Counts handled messages without storing any results.
+struct counting_visitor : detail::invoke_result_visitor {
+  size_t count = 0;
+
+  void operator()(error&) override {
+    ++count;
+  }
+
+  void operator()(message&) override {
+    ++count;
+  }
+};
+
+template <class Atom>
+auto handler(int64_t& sink) {
+  return [&sink](Atom, int32_t x) { sink += x; };
+}
+
+auto make_impl(int64_t& sink) {
+  return detail::make_behavior(
+    handler<add_atom>(sink), handler<close_atom>(sink),
+    handler<connect_atom>(sink), handler<contact_atom>(sink),
+    handler<delete_atom>(sink), handler<demonitor_atom>(sink),
+    handler<div_atom>(sink), handler<flush_atom>(sink),
+    handler<forward_atom>(sink), handler<get_atom>(sink),
+    handler<group_atom>(sink), handler<idle_atom>(sink),
+    handler<join_atom>(sink), handler<leave_atom>(sink),
+    handler<link_atom>(sink), handler<migrate_atom>(sink),
+    handler<monitor_atom>(sink), handler<mul_atom>(sink),
+    handler<ok_atom>(sink), handler<open_atom>(sink),
+    handler<pending_atom>(sink), handler<ping_atom>(sink),
+    handler<pong_atom>(sink), handler<publish_atom>(sink),
+    handler<put_atom>(sink), handler<receive_atom>(sink),
+    handler<redirect_atom>(sink), handler<reset_atom>(sink),
+    handler<resolve_atom>(sink), handler<spawn_atom>(sink),
+    handler<sub_atom>(sink), handler<update_atom>(sink));
+}
+
+template <class F>
+void measure(const char* scenario, const char* name, const config& cfg,
+             message msg, F f) {
+  counting_visitor visitor;
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < cfg.iterations; ++i)
+    f(visitor, msg);
+  auto t1 = std::chrono::steady_clock::now();
+  if (visitor.count != cfg.iterations) {
+    std::cerr << "*** handled " << visitor.count << " messages, expected "
+              << cfg.iterations << std::endl;
+    return;
+  }
+  auto n = static_cast<double>(cfg.iterations);
+  auto ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+  std::cout << std::setw(10) << std::left << scenario << std::setw(10) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << ns << " ns/msg" << std::endl;
+}
+
+} // namespace
+
+void caf_main(actor_system&, const config& cfg) {
+  int64_t sink = 0;
+  auto impl = make_impl(sink);
+  using impl_type = typename decltype(impl)::element_type;
+  std::make_index_sequence<std::tuple_size<impl_type::tuple_type>::value> is;
+  auto linear = [&](detail::invoke_result_visitor& f, message& msg) {
+    impl->invoke_impl(f, msg, is);
+  };
+  auto hashed = [&](detail::invoke_result_visitor& f, message& msg) {
+    impl->invoke_hashed(f, msg, is);
+  };
+  std::pair<const char*, message> scenarios[] = {
+    {"first", make_message(add_atom_v, int32_t{1})},
+    {"middle", make_message(mul_atom_v, int32_t{1})},
+    {"last", make_message(update_atom_v, int32_t{1})},
+  };
+  for (auto& [scenario, msg] : scenarios) {
+    measure(scenario, "linear", cfg, msg, linear);
+    measure(scenario, "hashed", cfg, msg, hashed);
+  }
+  // Prevent the compiler from dropping the handlers.
+  if (sink == 0)
+    std::cerr << "*** no handler ran" << std::endl;
+}
+
+CAF_MAIN()
@@ -0,0 +1,164 @@
+// Compares the enqueue-to-dequeue latency of the LIFO inbox and the MPSC
+// inbox for 1 to N producers.
+//
+// Each producer stamps its elements with the current time before pushing them
+// to the inbox. A single consumer fetches elements in FIFO order, i.e., it
+// reverses the list it takes from the LIFO inbox, and records the time each
+// element spent in the inbox.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/exec_main.hpp"
+#include "caf/intrusive/lifo_inbox.hpp"
+#include "caf/intrusive/mpsc_inbox.hpp"
+#include "caf/intrusive/singly_linked.hpp"
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct node : intrusive::singly_linked<node> {
+  clock_type::time_point enqueued;
+};
+
+struct node_policy {
+  using mapped_type = node;
+
+  using task_size_type = size_t;
+
+  using deficit_type = size_t;
+
+  using deleter_type = std::default_delete<mapped_type>;
+
+  using unique_pointer = std::unique_ptr<mapped_type, deleter_type>;
+};
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+      .add(max_producers, "producers,p", "maximum number of producers")
+      .add(messages, "messages,m", "number of messages per producer")
+      .add(pause, "pause", "busy-wait time between two messages in ns");
+  }
+  size_t max_producers = 4;
+  size_t messages = 100'000;
+  size_t pause = 0;
+};
+
+struct lifo_adapter {
+  static constexpr const char* name = "lifo_inbox";
+
+  intrusive::lifo_inbox<node_policy> inbox;
+
+  void push(node* x) {
+    inbox.push_front(x);
+  }
+
+  template <class F>
+  void fetch(F& f) {
+    // Reverse the LIFO list, just like fifo_inbox::fetch_more does.
+    node* head = nullptr;
+    for (auto ptr = inbox.take_head(); ptr != nullptr;) {
+      auto next = static_cast<node*>(ptr->next);
+      ptr->next = head;
+      head = ptr;
+      ptr = next;
+    }
+    while (head != nullptr) {
+      auto next = static_cast<node*>(head->next);
+      f(head);
+      head = next;
+    }
+  }
+};
+
+struct mpsc_adapter {
+  static constexpr const char* name = "mpsc_inbox";
+
+  intrusive::mpsc_inbox<node_policy> inbox;
+
+  void push(node* x) {
+    inbox.push_back(x);
+  }
+
+  template <class F>
+  void fetch(F& f) {
+    inbox.take_all(f);
+  }
+};
+
+void busy_wait(size_t ns) {
+  if (ns == 0)
+    return;
+  auto until = clock_type::now() + std::chrono::nanoseconds{ns};
+  while (clock_type::now() < until)
+    ; // nop
+}
+
+template <class Adapter>
+void run(const config& cfg, size_t num_producers) {
+  Adapter adapter;
+  auto total = num_producers * cfg.messages;
+  std::vector<int64_t> latencies;
+  latencies.reserve(total);
+  auto f = [&latencies](node* x) {
+    auto t = clock_type::now() - x->enqueued;
+    latencies.emplace_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
+    delete x;
+  };
+  std::vector<std::thread> producers;
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < num_producers; ++i)
+    producers.emplace_back([&] {
+      for (size_t j = 0; j < cfg.messages; ++j) {
+        auto x = new node;
+        x->enqueued = clock_type::now();
+        adapter.push(x);
+        busy_wait(cfg.pause);
+      }
+    });
+  while (latencies.size() < total)
+    adapter.fetch(f);
+  auto t1 = clock_type::now();
+  for (auto& t : producers)
+    t.join();
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+  auto secs = std::chrono::duration<double>(t1 - t0).count();
+  std::cout << std::setw(12) << std::left << Adapter::name << std::setw(4)
+            << std::right << num_producers << std::setw(12) << percentile(0.5)
+            << std::setw(12) << percentile(0.99) << std::setw(14)
+            << static_cast<uint64_t>(total / secs) << std::endl;
+}
+
+} // namespace
+
+void caf_main(actor_system&, const config& cfg) {
+  if (cfg.max_producers == 0 || cfg.messages == 0) {
+    std::cerr << "*** producers and messages must be positive" << std::endl;
+    return;
+  }
+  std::cout << std::setw(12) << std::left << "inbox" << std::setw(4)
+            << std::right << "n" << std::setw(12) << "p50 (ns)" << std::setw(12)
+            << "p99 (ns)" << std::setw(14) << "msgs/s" << std::endl;
+  for (size_t n = 1; n <= cfg.max_producers; ++n) {
+    run<lifo_adapter>(cfg, n);
+    run<mpsc_adapter>(cfg, n);
+  }
+}
+
+CAF_MAIN()
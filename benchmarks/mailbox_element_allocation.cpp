@@ -0,0 +1,176 @@
+// Compares malloc with the slab allocator for blocks of mailbox-element size.
+//
+// The local scenario allocates and releases blocks on the same thread, like an
+// actor that sends a message to itself. In the remote scenario, a producer
+// allocates blocks and a consumer releases them, like a sender enqueueing to a
+// mailbox that another worker drains. The last scenario creates actual
+// mailbox elements and thus uses whichever allocator CAF was built with (see
+// CAF_ENABLE_SLAB_ALLOCATOR).
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/slab_allocator.hpp"
+#include "caf/exec_main.hpp"
+#include "caf/mailbox_element.hpp"
+
+using namespace caf;
+
+using detail::slab_allocator;
+
+namespace {
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+      .add(iterations, "iterations,i", "number of allocations per scenario")
+      .add(batch_size, "batch-size,b",
+           "number of blocks the producer hands over at once");
+  }
+  size_t iterations = 10'000'000;
+  size_t batch_size = 256;
+};
+
+struct malloc_policy {
+  static constexpr const char* name = "malloc";
+
+  static void* allocate(size_t size) {
+    return malloc(size);
+  }
+
+  static void deallocate(void* ptr, size_t) {
+    free(ptr);
+  }
+};
+
+struct slab_policy {
+  static constexpr const char* name = "slab_allocator";
+
+  static void* allocate(size_t size) {
+    return slab_allocator::allocate(size);
+  }
+
+  static void deallocate(void* ptr, size_t size) {
+    slab_allocator::deallocate(ptr, size);
+  }
+};
+
+constexpr size_t block_size = sizeof(mailbox_element);
+
+template <class Policy>
+void run_local(const config& cfg) {
+  // Keep a few blocks alive to mimic a mailbox with some queued messages.
+  std::deque<void*> live;
+  for (size_t i = 0; i < cfg.batch_size; ++i)
+    live.emplace_back(Policy::allocate(block_size));
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    live.emplace_back(Policy::allocate(block_size));
+    Policy::deallocate(live.front(), block_size);
+    live.pop_front();
+  }
+  for (auto ptr : live)
+    Policy::deallocate(ptr, block_size);
+}
+
+template <class Policy>
+void run_remote(const config& cfg) {
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::vector<void*>> batches;
+  bool done = false;
+  std::thread consumer{[&] {
+    std::unique_lock<std::mutex> guard{mtx};
+    for (;;) {
+      cv.wait(guard, [&] { return done || !batches.empty(); });
+      if (batches.empty())
+        return;
+      auto batch = std::move(batches.front());
+      batches.pop_front();
+      guard.unlock();
+      for (auto ptr : batch)
+        Policy::deallocate(ptr, block_size);
+      guard.lock();
+    }
+  }};
+  std::vector<void*> batch;
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    batch.emplace_back(Policy::allocate(block_size));
+    if (batch.size() == cfg.batch_size || i + 1 == cfg.iterations) {
+      std::unique_lock<std::mutex> guard{mtx};
+      batches.emplace_back(std::move(batch));
+      batch.clear();
+      cv.notify_one();
+    }
+  }
+  {
+    std::unique_lock<std::mutex> guard{mtx};
+    done = true;
+    cv.notify_one();
+  }
+  consumer.join();
+}
+
+void run_mailbox_elements(const config& cfg) {
+  for (size_t i = 0; i < cfg.iterations; ++i) {
+    auto ptr = make_mailbox_element(nullptr, make_message_id(),
+                                    mailbox_element::forwarding_stack{},
+                                    static_cast<int32_t>(i));
+    ptr.reset();
+  }
+}
+
+// Prints the runtime per allocation and how many allocations reached the
+// system allocator. We can only count the latter for the slab allocator. For
+// malloc, callers pass the number of allocations per iteration as `sys_per_op`.
+template <class F>
+void measure(const char* scenario, const char* name, const config& cfg, F f,
+             double sys_per_op = -1.0) {
+  auto stats0 = slab_allocator::stats();
+  auto t0 = std::chrono::steady_clock::now();
+  f(cfg);
+  auto t1 = std::chrono::steady_clock::now();
+  auto stats1 = slab_allocator::stats();
+  auto n = static_cast<double>(cfg.iterations);
+  auto ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+  std::cout << std::setw(10) << std::left << scenario << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << ns << " ns/op";
+  if (sys_per_op < 0) {
+    auto sys = stats1.system_allocations - stats0.system_allocations;
+    sys_per_op = static_cast<double>(sys) / n;
+  }
+  std::cout << std::setw(12) << std::setprecision(6) << sys_per_op
+            << " sys/op" << std::endl;
+}
+
+} // namespace
+
+void caf_main(actor_system&, const config& cfg) {
+  if (cfg.iterations == 0 || cfg.batch_size == 0) {
+    std::cerr << "*** iterations and batch-size must be positive" << std::endl;
+    return;
+  }
+  std::cout << cfg.iterations << " allocations of " << block_size
+            << " bytes per scenario" << std::endl;
+  measure("local", malloc_policy::name, cfg, run_local<malloc_policy>, 1.0);
+  measure("local", slab_policy::name, cfg, run_local<slab_policy>);
+  measure("remote", malloc_policy::name, cfg, run_remote<malloc_policy>, 1.0);
+  measure("remote", slab_policy::name, cfg, run_remote<slab_policy>);
+#ifdef CAF_ENABLE_SLAB_ALLOCATOR
+  measure("message", "mailbox_element", cfg, run_mailbox_elements);
+#else
+  // One allocation for the element and one for its content.
+  measure("message", "mailbox_element", cfg, run_mailbox_elements, 2.0);
+#endif
+}
+
+CAF_MAIN()
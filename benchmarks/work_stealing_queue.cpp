@@ -0,0 +1,114 @@
+// Compares the job queues of the work-stealing scheduler under contention.
+//
+// Each simulated worker owns one queue. All jobs start at the first worker to
+// force the others into stealing. Whenever a worker runs a job, it either
+// re-schedules the job locally (`prepend`) or hands it to a random peer
+// (`append`) until the job has completed its hops.
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/work_stealing_queue.hpp"
+#include "caf/exec_main.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct job {
+  size_t hops;
+};
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+      .add(workers, "workers,w", "number of simulated workers")
+      .add(jobs, "jobs,j", "number of jobs")
+      .add(hops, "hops", "number of times each job gets re-scheduled")
+      .add(remote_ratio, "remote-ratio,r",
+           "re-schedule every n-th hop at a random peer");
+  }
+  size_t workers = 4;
+  size_t jobs = 10'000;
+  size_t hops = 100;
+  size_t remote_ratio = 8;
+};
+
+template <class Queue>
+double run(const config& cfg) {
+  std::vector<std::unique_ptr<Queue>> queues;
+  for (size_t i = 0; i < cfg.workers; ++i)
+    queues.emplace_back(std::make_unique<Queue>());
+  std::vector<job> jobs(cfg.jobs, job{cfg.hops});
+  for (auto& x : jobs)
+    queues[0]->append(&x);
+  std::atomic<size_t> completed{0};
+  auto worker = [&](size_t id) {
+    std::minstd_rand rng{static_cast<unsigned>(id + 1)};
+    std::uniform_int_distribution<size_t> victims{0, cfg.workers - 1};
+    auto& self = *queues[id];
+    size_t n = 0;
+    while (completed.load(std::memory_order_relaxed) < cfg.jobs) {
+      auto ptr = self.take_head();
+      if (ptr == nullptr) {
+        auto victim = victims(rng);
+        if (victim != id)
+          ptr = queues[victim]->take_tail();
+        if (ptr == nullptr)
+          continue;
+      }
+      if (--ptr->hops == 0)
+        completed.fetch_add(1, std::memory_order_relaxed);
+      else if (++n % cfg.remote_ratio == 0)
+        queues[victims(rng)]->append(ptr);
+      else
+        self.prepend(ptr);
+    }
+  };
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < cfg.workers; ++i)
+    threads.emplace_back(worker, i);
+  for (auto& t : threads)
+    t.join();
+  auto t1 = std::chrono::steady_clock::now();
+  // Drain any leftovers, since workers exit as soon as all jobs completed.
+  for (auto& q : queues)
+    while (q->take_head() != nullptr)
+      ; // nop
+  return std::chrono::duration<double>(t1 - t0).count();
+}
+
+void print(const char* name, const config& cfg, double secs) {
+  auto ops = static_cast<double>(cfg.jobs * cfg.hops);
+  std::cout << std::setw(20) << std::left << name << std::setw(12)
+            << std::right << std::fixed << std::setprecision(4) << secs << " s"
+            << std::setw(16) << static_cast<uint64_t>(ops / secs) << " ops/s"
+            << std::endl;
+}
+
+} // namespace
+
+void caf_main(actor_system&, const config& cfg) {
+  if (cfg.workers == 0 || cfg.remote_ratio == 0) {
+    std::cerr << "*** workers and remote-ratio must be positive" << std::endl;
+    return;
+  }
+  std::cout << cfg.workers << " workers, " << cfg.jobs << " jobs, " << cfg.hops
+            << " hops per job" << std::endl;
+  print("double_ended_queue", cfg,
+        run<detail::double_ended_queue<job>>(cfg));
+  print("work_stealing_queue", cfg,
+        run<detail::work_stealing_queue<job>>(cfg));
+}
+
+CAF_MAIN()
@@ -22,6 +22,7 @@
 #include "caf/exit_reason.hpp"
 #include "caf/fwd.hpp"
 #include "caf/intrusive_ptr.hpp"
+#include "caf/mailbox_batch.hpp"
 #include "caf/mailbox_element.hpp"
 #include "caf/message_id.hpp"
 #include "caf/node_id.hpp"
@@ -61,6 +62,11 @@ public:
   /// This `enqueue` variant allows to define forwarding chains.
   virtual void enqueue(mailbox_element_ptr what, execution_unit* host) = 0;
 
+  /// Enqueues all elements of `what` in order. Actors with a mailbox override
+  /// this member function to enqueue the entire batch with a single atomic
+  /// operation. The default implementation calls `enqueue` for each element.
+  virtual void enqueue_batch(mailbox_batch what, execution_unit* host);
+
   /// Attaches `ptr` to this actor. The actor will call `ptr->detach(...)` on
   /// exit, or immediately if it already finished execution.
   virtual void attach(attachable_ptr ptr) = 0;
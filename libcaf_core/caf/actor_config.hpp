@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <string>
 
 #include "caf/abstract_channel.hpp"
@@ -12,6 +14,8 @@
 #include "caf/detail/unique_function.hpp"
 #include "caf/fwd.hpp"
 #include "caf/input_range.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf {
 
@@ -22,6 +26,11 @@ public:
 
   using init_fun_type = detail::unique_function<behavior(local_actor*)>;
 
+  // -- constants --------------------------------------------------------------
+
+  /// Denotes that an actor has no preferred NUMA node.
+  static constexpr size_t any_numa_node = std::numeric_limits<size_t>::max();
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit actor_config(execution_unit* host = nullptr,
@@ -35,6 +44,26 @@ public:
   input_range<const group>* groups;
   detail::unique_function<behavior(local_actor*)> init_fun;
 
+  /// Preferred NUMA node for running the actor. Only has an effect with the
+  /// scheduler policy `numa-stealing`.
+  size_t numa_node;
+
+  /// Maximum time the actor may run before yielding its worker. The default
+  /// value 0 selects `caf.scheduler.max-time-slice` and `infinite` disables
+  /// time slices for this actor.
+  timespan max_time_slice;
+
+  /// Scheduler domain for running the actor or `nullptr` for the default
+  /// scheduler. See `actor_system::scheduler_domain`.
+  scheduler::abstract_coordinator* scheduler_domain;
+
+  /// Maximum number of ordinary messages in the mailbox of the actor. The
+  /// default value 0 disables the limit.
+  size_t mailbox_capacity;
+
+  /// Selects how the actor handles messages that exceed `mailbox_capacity`.
+  mailbox_overflow_policy overflow_policy;
+
   // -- properties -------------------------------------------------------------
 
   actor_config& add_flag(int x) {
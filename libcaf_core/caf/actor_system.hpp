@@ -13,6 +13,7 @@
 #include <mutex>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_cast.hpp"
@@ -176,6 +177,10 @@ public:
 
     /// Counts the total number of messages that wait in a mailbox.
     telemetry::int_gauge* queued_messages;
+
+    /// Counts messages that exceeded the capacity of a bounded mailbox. Uses
+    /// the label dimension *policy* (the overflow policy of the mailbox).
+    telemetry::int_counter_family* mailbox_overflows;
   };
 
   /// Metrics that some actors may collect in addition to the base metrics. All
@@ -192,6 +197,12 @@ public:
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge_family* mailbox_size = nullptr;
 
+    /// Counts how many skipped messages are currently waiting in the stash.
+    telemetry::int_gauge_family* stash_size = nullptr;
+
+    /// Counts how often actors retried skipped messages.
+    telemetry::int_counter_family* stash_retries = nullptr;
+
     struct {
       // -- inbound ------------------------------------------------------------
 
@@ -290,6 +301,9 @@ public:
   /// Returns the scheduler instance.
   scheduler::abstract_coordinator& scheduler();
 
+  /// Returns the scheduler domain `name` or `nullptr` if no such domain exists.
+  scheduler::abstract_coordinator* scheduler_domain(string_view name);
+
   /// Returns the system-wide event logger.
   caf::logger& logger();
 
@@ -510,6 +524,64 @@ public:
     return spawn_in_groups<T, Os>({grp}, std::forward<Ts>(xs)...);
   }
 
+  /// Returns a new functor-based actor that runs in the scheduler domain
+  /// `name`. Falls back to the default scheduler if no such domain exists.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_in_domain(string_view name, F fun, Ts&&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    actor_config cfg;
+    cfg.scheduler_domain = domain_or_default(name);
+    return spawn_functor<Os>(detail::bool_token<spawnable>{}, cfg, fun,
+                             std::forward<Ts>(xs)...);
+  }
+
+  /// Returns a new class-based actor that runs in the scheduler domain
+  /// `name`. Falls back to the default scheduler if no such domain exists.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C> spawn_in_domain(string_view name, Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.scheduler_domain = domain_or_default(name);
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
+  /// Returns a new functor-based actor with a mailbox that holds at most
+  /// `capacity` ordinary messages. Handles additional messages according to
+  /// `policy`.
+  template <spawn_options Os = no_spawn_options, class F, class... Ts>
+  infer_handle_from_fun_t<F>
+  spawn_bounded(size_t capacity, mailbox_overflow_policy policy, F fun,
+                Ts&&... xs) {
+    using impl = infer_impl_from_fun_t<F>;
+    check_invariants<impl>();
+    static constexpr bool spawnable = detail::spawnable<F, impl, Ts...>();
+    static_assert(spawnable,
+                  "cannot spawn function-based actor with given arguments");
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.overflow_policy = policy;
+    return spawn_functor<Os>(detail::bool_token<spawnable>{}, cfg, fun,
+                             std::forward<Ts>(xs)...);
+  }
+
+  /// Returns a new class-based actor with a mailbox that holds at most
+  /// `capacity` ordinary messages. Handles additional messages according to
+  /// `policy`.
+  template <class C, spawn_options Os = no_spawn_options, class... Ts>
+  infer_handle_from_class_t<C>
+  spawn_bounded(size_t capacity, mailbox_overflow_policy policy, Ts&&... xs) {
+    check_invariants<C>();
+    actor_config cfg;
+    cfg.mailbox_capacity = capacity;
+    cfg.overflow_policy = policy;
+    return spawn_impl<C, Os>(cfg, detail::spawn_fwd<Ts>(xs)...);
+  }
+
   /// Returns whether this actor system calls `await_all_actors_done`
   /// in its destructor before shutting down.
   bool await_actors_before_shutdown() const {
@@ -551,6 +623,12 @@ public:
     return metrics_actors_excludes_;
   }
 
+  /// Returns how many messages actors with metrics receive for each message
+  /// that carries an enqueue timestamp.
+  size_t metrics_actors_sample_rate() const noexcept {
+    return metrics_actors_sample_rate_;
+  }
+
   template <class C, spawn_options Os, class... Ts>
   infer_handle_from_class_t<C> spawn_impl(actor_config& cfg, Ts&&... xs) {
     static_assert(is_unbound(Os),
@@ -642,6 +720,9 @@ private:
   dyn_spawn_impl(const std::string& name, message& args, execution_unit* ctx,
                  bool check_interface, optional<const mpi&> expected_ifs);
 
+  /// Returns the scheduler domain `name` or `nullptr` after logging a warning.
+  scheduler::abstract_coordinator* domain_or_default(string_view name);
+
   /// Sets the internal actor for dynamic spawn operations.
   void spawn_serv(strong_actor_ptr x) {
     spawn_serv_ = std::move(x);
@@ -681,6 +762,9 @@ private:
   /// Stores optional actor system components.
   module_array modules_;
 
+  /// Stores additional schedulers from `caf.scheduler.domains`.
+  std::vector<module_ptr> scheduler_domains_;
+
   /// Provides pseudo scheduling context to actors.
   scoped_execution_unit dummy_execution_unit_;
 
@@ -717,6 +801,10 @@ private:
   /// for faster lookups at runtime.
   std::vector<std::string> metrics_actors_excludes_;
 
+  /// Caches the configuration parameter
+  /// `caf.metrics-filters.actors.sample-rate` for faster lookups at runtime.
+  size_t metrics_actors_sample_rate_ = 1;
+
   /// Caches families for optional actor metrics.
   actor_metric_families_t actor_metric_families_;
 
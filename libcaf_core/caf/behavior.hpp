@@ -95,6 +95,11 @@ public:
     return impl_ ? impl_->invoke(f, xs) : false;
   }
 
+  /// Checks whether this behavior has a handler for messages of given types.
+  bool accepts(type_id_list types) const {
+    return impl_ ? impl_->accepts(types) : false;
+  }
+
   /// Checks whether this behavior is not empty.
   operator bool() const {
     return static_cast<bool>(impl_);
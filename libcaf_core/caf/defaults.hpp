@@ -78,7 +78,10 @@ namespace caf::defaults::scheduler {
 constexpr auto policy = string_view{"stealing"};
 constexpr auto profiling_output_file = string_view{""};
 constexpr auto max_throughput = std::numeric_limits<size_t>::max();
+constexpr auto max_time_slice = timespan{0};
 constexpr auto profiling_resolution = timespan(100'000'000);
+constexpr auto profiling_sample_rate = size_t{100};
+constexpr auto profiling_buffer_size = size_t{4096};
 
 } // namespace caf::defaults::scheduler
 
@@ -88,12 +91,46 @@ constexpr auto aggressive_poll_attempts = size_t{100};
 constexpr auto aggressive_steal_interval = size_t{10};
 constexpr auto moderate_poll_attempts = size_t{500};
 constexpr auto moderate_steal_interval = size_t{5};
-constexpr auto moderate_sleep_duration = timespan{50'000};
+[[deprecated("this parameter no longer has any effect")]] //
+constexpr auto moderate_sleep_duration
+  = timespan{50'000};
 constexpr auto relaxed_steal_interval = size_t{1};
 constexpr auto relaxed_sleep_duration = timespan{10'000'000};
+constexpr auto max_steal_batch = size_t{32};
+constexpr auto run_next_limit = size_t{0};
+constexpr auto max_urgent_streak = size_t{8};
 
 } // namespace caf::defaults::work_stealing
 
+namespace caf::defaults::numa_stealing {
+
+/// Selects the CPUs for pinning workers. An empty list selects all CPUs.
+constexpr auto cpu_list = string_view{""};
+
+/// Configures whether workers run on a fixed CPU.
+constexpr auto pin_workers = true;
+
+/// Configures how often idle workers try to steal from other NUMA nodes.
+constexpr auto inter_node_steal_interval = size_t{4};
+
+} // namespace caf::defaults::numa_stealing
+
+namespace caf::defaults::elastic_stealing {
+
+/// Configures how many workers remain active when the system is idle.
+constexpr auto min_threads = size_t{1};
+
+/// Configures how many jobs in the queue of a worker signal a backlog.
+constexpr auto grow_threshold = size_t{16};
+
+/// Configures the minimum time between activating two workers.
+constexpr auto grow_interval = timespan{10'000'000};
+
+/// Configures how long workers remain idle before becoming inactive.
+constexpr auto idle_timeout = timespan{10'000'000'000};
+
+} // namespace caf::defaults::elastic_stealing
+
 namespace caf::defaults::logger::file {
 
 constexpr auto format = string_view{"%r %c %p %a %t %C %M %F:%L %m%n"};
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -25,6 +27,7 @@
 #include "caf/skip.hpp"
 #include "caf/timeout_definition.hpp"
 #include "caf/timespan.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/typed_message_view.hpp"
 #include "caf/typed_response_promise.hpp"
 #include "caf/variant.hpp"
@@ -53,6 +56,10 @@ public:
 
   optional<message> invoke(message&);
 
+  /// Checks whether `invoke` may succeed for messages of given types. The
+  /// default implementation conservatively returns `true`.
+  virtual bool accepts(type_id_list types) const noexcept;
+
   virtual void handle_timeout();
 
   timespan timeout() const noexcept {
@@ -89,6 +96,69 @@ struct dummy_timeout_definition {
   }
 };
 
+/// Computes a hash value from a size-prefixed list of type IDs.
+constexpr uint32_t hash_type_ids(const type_id_t* xs) noexcept {
+  // FNV-1a over the 16-bit type IDs.
+  uint32_t result = 2166136261u;
+  for (size_t i = 0; i <= xs[0]; ++i) {
+    result ^= xs[i];
+    result *= 16777619u;
+  }
+  return result;
+}
+
+/// Computes the hash for the argument types of a message handler at compile
+/// time. Produces the same result as `hash_type_ids` for a message with
+/// matching types.
+template <class List>
+struct type_list_hash;
+
+template <class... Ts>
+struct type_list_hash<type_list<Ts...>> {
+  static constexpr type_id_t ids[] = {
+    static_cast<type_id_t>(sizeof...(Ts)),
+    type_id_v<typename strip_param<Ts>::type>...,
+  };
+
+  static constexpr uint32_t value = hash_type_ids(ids);
+};
+
+/// Maps the hashes of the argument types to the index of the first matching
+/// handler, using open addressing with linear probing.
+template <size_t NumHandlers>
+struct behavior_dispatch_table {
+  /// Number of slots, i.e., the smallest power of two that is at least twice
+  /// the number of handlers.
+  static constexpr size_t capacity = [] {
+    size_t result = 1;
+    while (result < 2 * NumHandlers)
+      result <<= 1;
+    return result;
+  }();
+
+  static constexpr size_t mask = capacity - 1;
+
+  /// Stores the hash of the handler in each occupied slot.
+  std::array<uint32_t, capacity> hashes;
+
+  /// Stores the index of the handler plus one, i.e., 0 marks empty slots.
+  std::array<size_t, capacity> slots;
+
+  constexpr behavior_dispatch_table(
+    const std::array<uint32_t, NumHandlers>& xs) noexcept
+    : hashes(), slots() {
+    // Inserting in order of the handlers makes sure that the lookup finds the
+    // first handler if several handlers have the same signature.
+    for (size_t i = 0; i < NumHandlers; ++i) {
+      auto pos = xs[i] & mask;
+      while (slots[pos] != 0)
+        pos = (pos + 1) & mask;
+      hashes[pos] = xs[i];
+      slots[pos] = i + 1;
+    }
+  }
+};
+
 template <class Tuple, class TimeoutDefinition = dummy_timeout_definition>
 class default_behavior_impl;
 
@@ -100,6 +170,10 @@ public:
 
   using tuple_type = std::tuple<Ts...>;
 
+  /// Behaviors with at least this many handlers look up the handler for a
+  /// message in a dispatch table instead of trying each handler in turn.
+  static constexpr size_t dispatch_table_threshold = 8;
+
   default_behavior_impl(tuple_type&& tup, TimeoutDefinition timeout_definition)
     : super(timeout_definition.timeout),
       cases_(std::move(tup)),
@@ -108,31 +182,77 @@ public:
   }
 
   virtual bool invoke(detail::invoke_result_visitor& f, message& xs) override {
-    return invoke_impl(f, xs, std::make_index_sequence<sizeof...(Ts)>{});
+    std::make_index_sequence<sizeof...(Ts)> indexes;
+    if constexpr (sizeof...(Ts) >= dispatch_table_threshold)
+      return invoke_hashed(f, xs, indexes);
+    else
+      return invoke_impl(f, xs, indexes);
   }
 
   template <size_t... Is>
   bool invoke_impl(detail::invoke_result_visitor& f, message& msg,
                    std::index_sequence<Is...>) {
-    [[maybe_unused]] auto dispatch = [&](auto& fun) {
-      using fun_type = std::decay_t<decltype(fun)>;
-      using trait = get_callable_trait_t<fun_type>;
-      auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
-      if (arg_types == msg.types()) {
-        typename trait::message_view_type xs{msg};
-        using fun_result = decltype(detail::apply_args(fun, xs));
-        if constexpr (std::is_same<void, fun_result>::value) {
-          detail::apply_args(fun, xs);
-          f(unit);
-        } else {
-          auto invoke_res = detail::apply_args(fun, xs);
-          f(invoke_res);
-        }
+    return (invoke_case(std::get<Is>(cases_), f, msg) || ...);
+  }
+
+  template <size_t... Is>
+  bool invoke_hashed(detail::invoke_result_visitor& f, message& msg,
+                     std::index_sequence<Is...>) {
+    using invoker = bool (default_behavior_impl::*)(invoke_result_visitor&,
+                                                    message&);
+    static constexpr invoker invokers[] = {
+      &default_behavior_impl::template invoke_at<Is>...,
+    };
+    static constexpr behavior_dispatch_table<sizeof...(Ts)> table{
+      {{type_list_hash<typename get_callable_trait_t<Ts>::decayed_arg_types>::
+          value...}}};
+    using table_type = behavior_dispatch_table<sizeof...(Ts)>;
+    auto hash = hash_type_ids(msg.types().data());
+    for (auto pos = hash & table_type::mask; table.slots[pos] != 0;
+         pos = (pos + 1) & table_type::mask)
+      if (table.hashes[pos] == hash
+          && (this->*invokers[table.slots[pos] - 1])(f, msg))
         return true;
+    return false;
+  }
+
+  template <size_t I>
+  bool invoke_at(detail::invoke_result_visitor& f, message& msg) {
+    return invoke_case(std::get<I>(cases_), f, msg);
+  }
+
+  template <class Fun>
+  static bool invoke_case(Fun& fun, detail::invoke_result_visitor& f,
+                          message& msg) {
+    using trait = get_callable_trait_t<Fun>;
+    auto arg_types = to_type_id_list<typename trait::decayed_arg_types>();
+    if (arg_types == msg.types()) {
+      typename trait::message_view_type xs{msg};
+      using fun_result = decltype(detail::apply_args(fun, xs));
+      if constexpr (std::is_same<void, fun_result>::value) {
+        detail::apply_args(fun, xs);
+        f(unit);
+      } else {
+        auto invoke_res = detail::apply_args(fun, xs);
+        f(invoke_res);
       }
-      return false;
+      return true;
+    }
+    return false;
+  }
+
+  bool accepts(type_id_list types) const noexcept override {
+    return accepts_impl(types, std::make_index_sequence<sizeof...(Ts)>{});
+  }
+
+  template <size_t... Is>
+  bool accepts_impl(type_id_list types, std::index_sequence<Is...>) const {
+    [[maybe_unused]] auto matches = [types](const auto& fun) {
+      using fun_type = std::decay_t<decltype(fun)>;
+      using trait = get_callable_trait_t<fun_type>;
+      return to_type_id_list<typename trait::decayed_arg_types>() == types;
     };
-    return (dispatch(std::get<Is>(cases_)) || ...);
+    return (matches(std::get<Is>(cases_)) || ...);
   }
 
   void handle_timeout() override {
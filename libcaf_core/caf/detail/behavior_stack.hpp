@@ -43,12 +43,24 @@ public:
     return elements_.back();
   }
 
+  const behavior& back() const {
+    CAF_ASSERT(!empty());
+    return elements_.back();
+  }
+
+  /// Returns a value that changes whenever the top of the stack may change.
+  size_t version() const noexcept {
+    return version_;
+  }
+
   void push_back(behavior&& what) {
+    ++version_;
     elements_.emplace_back(std::move(what));
   }
 
   template <class... Ts>
   void emplace_back(Ts&&... xs) {
+    ++version_;
     elements_.emplace_back(std::forward<Ts>(xs)...);
   }
 
@@ -59,6 +71,7 @@ public:
 private:
   std::vector<behavior> elements_;
   std::vector<behavior> erased_elements_;
+  size_t version_ = 0;
 };
 
 } // namespace caf::detail
@@ -0,0 +1,137 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// A reference count that favors the thread that created an object. The
+/// owning thread modifies a *biased* count without atomic read-modify-write
+/// operations, while all other threads modify a *shared* count atomically.
+/// When the biased count drops to zero, the owner merges both counts and
+/// gives up ownership.
+///
+/// Since only the sum of both counts is meaningful, the shared count becomes
+/// negative if other threads release references that the owner handed out.
+/// In this case, the thread that first drives the shared count below zero
+/// asks the owner to merge the counts and to dispose the object if no
+/// references remain.
+///
+/// Threads only own objects while running a job, i.e., between calling
+/// `begin_owner_scope` and `end_owner_scope`. The owner handles pending merge
+/// requests when leaving the scope. Outside of a scope, threads that request
+/// a merge perform it themselves. Hence, releasing an object never depends on
+/// the owner running another job. Objects created outside of a scope have no
+/// owner and always use the shared count.
+///
+/// Reference:
+/// Jiho Choi, Thomas Shull, and Josep Torrellas. 2018. Biased Reference
+/// Counting: Minimizing Atomic Operations in Garbage Collection. PACT '18.
+class CAF_CORE_EXPORT biased_ref_count {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Destroys the object that holds the reference count.
+  using disposer = void (*)(void* obj);
+
+  /// Bookkeeping of a thread that may own objects.
+  struct owner_record;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Initializes the count to 1. The calling thread owns the object if it
+  /// runs inside an owner scope.
+  biased_ref_count() noexcept;
+
+  /// Initializes the count to 1 without assigning an owner.
+  explicit biased_ref_count(std::nullptr_t) noexcept;
+
+  biased_ref_count(const biased_ref_count&) = delete;
+
+  biased_ref_count& operator=(const biased_ref_count&) = delete;
+
+  // -- reference counting -----------------------------------------------------
+
+  /// Increases the count by one.
+  void inc() noexcept;
+
+  /// Decreases the count by one.
+  /// @param obj The object that holds this reference count.
+  /// @param fn Disposes `obj` if the count drops to zero later.
+  /// @returns `true` if the count dropped to zero and the caller must dispose
+  ///          the object, `false` otherwise.
+  bool dec(void* obj, disposer fn) noexcept;
+
+  /// Returns the current value of the count. The result is only exact if no
+  /// other thread modifies the count concurrently.
+  size_t count() const noexcept;
+
+  /// Queries whether the count is 1.
+  bool unique() const noexcept {
+    return count() == 1;
+  }
+
+  /// Queries whether this object has an owner.
+  bool biased() const noexcept {
+    return owner_.load(std::memory_order_relaxed) != nullptr;
+  }
+
+  // -- owner scopes -----------------------------------------------------------
+
+  /// Enables the calling thread to own objects until calling
+  /// `end_owner_scope`.
+  static void begin_owner_scope() noexcept;
+
+  /// Handles pending merge requests and ends the owner scope of the calling
+  /// thread.
+  static void end_owner_scope() noexcept;
+
+private:
+  // -- constants --------------------------------------------------------------
+
+  /// Set after merging the biased count into the shared count.
+  static constexpr int64_t merged_flag = 0x01;
+
+  /// Set while the object waits for its owner to merge the counts.
+  static constexpr int64_t queued_flag = 0x02;
+
+  /// The shared count stores the flags in the lower bits.
+  static constexpr int64_t count_shift = 2;
+
+  /// Adds or removes one reference from the shared count.
+  static constexpr int64_t one = int64_t{1} << count_shift;
+
+  // -- utility functions ------------------------------------------------------
+
+  friend struct owner_record;
+
+  static int64_t count_of(int64_t x) noexcept {
+    return x >> count_shift;
+  }
+
+  /// Merges the biased count into the shared count. Called by the owner or by
+  /// a thread that acts on behalf of an idle owner.
+  /// @returns `true` if the count dropped to zero.
+  bool merge() noexcept;
+
+  // -- member variables -------------------------------------------------------
+
+  /// Points to the owning thread or is `nullptr` after merging.
+  std::atomic<owner_record*> owner_;
+
+  /// Counts references of the owner. Only the owner (or a thread acting on
+  /// behalf of an idle owner) writes to this count.
+  std::atomic<uint32_t> biased_;
+
+  /// Counts references of all other threads plus flags.
+  std::atomic<int64_t> shared_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,187 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "caf/config.hpp"
+
+namespace caf::detail {
+
+/// A lock-free, growable work-stealing deque based on the algorithm by Chase
+/// and Lev with the memory orderings proposed by Lê et al. in "Correct and
+/// Efficient Work-Stealing for Weak Memory Models" (PPoPP '13).
+///
+/// The owner pushes and pops at the bottom (LIFO), while any number of thieves
+/// concurrently take elements from the top (FIFO). Only the owner may call
+/// `push_bottom` and `take_bottom`. Pushing never allocates unless the deque
+/// needs to grow. Replaced buffers stay alive until the deque gets destroyed,
+/// because thieves may still read from them.
+template <class T>
+class chase_lev_deque {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type*;
+
+  static constexpr size_type default_capacity = 256;
+
+  explicit chase_lev_deque(size_type capacity = default_capacity)
+    : top_(0), bottom_(0) {
+    auto init = round_up(capacity);
+    buffers_.emplace_back(std::make_unique<buffer>(init));
+    buf_ = buffers_.back().get();
+  }
+
+  chase_lev_deque(const chase_lev_deque&) = delete;
+
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+  // -- owner interface --------------------------------------------------------
+
+  /// Pushes `value` to the bottom of the deque.
+  /// @pre `value != nullptr`
+  /// @warning Must only be called by the owner.
+  void push_bottom(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto buf = buf_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(buf->capacity()) - 1) {
+      buf = grow(buf, t, b);
+      buf_.store(buf, std::memory_order_release);
+    }
+    buf->store(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Removes the most recently pushed element or returns `nullptr` if the
+  /// deque is empty.
+  /// @warning Must only be called by the owner.
+  pointer take_bottom() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto buf = buf_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // Empty deque.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto result = buf->load(b);
+    if (t == b) {
+      // Last element: race against thieves.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // -- thief interface --------------------------------------------------------
+
+  /// Removes the oldest element or returns `nullptr` if the deque is empty.
+  /// Safe to call from any thread.
+  pointer take_top() {
+    for (;;) {
+      auto t = top_.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto b = bottom_.load(std::memory_order_acquire);
+      if (t >= b)
+        return nullptr;
+      auto buf = buf_.load(std::memory_order_acquire);
+      auto result = buf->load(t);
+      if (top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+        return result;
+      // Lost the race against another thief or the owner, try again.
+    }
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns an estimate of the number of elements in the deque. Safe to call
+  /// from any thread.
+  size_type size() const noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0u;
+  }
+
+  /// Checks whether the deque is (approximately) empty. Safe to call from any
+  /// thread.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns the current capacity of the underlying ring buffer.
+  /// @warning Must only be called by the owner.
+  size_type capacity() const noexcept {
+    return buf_.load(std::memory_order_relaxed)->capacity();
+  }
+
+private:
+  class buffer {
+  public:
+    explicit buffer(size_type capacity)
+      : mask_(capacity - 1), xs_(new std::atomic<pointer>[capacity]) {
+      // nop
+    }
+
+    size_type capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+    void store(int64_t pos, pointer value) noexcept {
+      xs_[static_cast<size_type>(pos) & mask_].store(value,
+                                                     std::memory_order_relaxed);
+    }
+
+    pointer load(int64_t pos) const noexcept {
+      return xs_[static_cast<size_type>(pos) & mask_].load(
+        std::memory_order_relaxed);
+    }
+
+  private:
+    size_type mask_;
+    std::unique_ptr<std::atomic<pointer>[]> xs_;
+  };
+
+  static size_type round_up(size_type n) noexcept {
+    size_type result = 2;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+  buffer* grow(buffer* old, int64_t t, int64_t b) {
+    buffers_.emplace_back(std::make_unique<buffer>(old->capacity() * 2));
+    auto result = buffers_.back().get();
+    for (auto i = t; i != b; ++i)
+      result->store(i, old->load(i));
+    return result;
+  }
+
+  // Read by thieves, written by thieves and the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> top_;
+
+  // Written by the owner only.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_;
+
+  // Current ring buffer.
+  std::atomic<buffer*> buf_;
+
+  // Owns all buffers, including retired ones that thieves may still access.
+  std::vector<std::unique_ptr<buffer>> buffers_;
+};
+
+} // namespace caf::detail
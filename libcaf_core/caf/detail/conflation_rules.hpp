@@ -0,0 +1,94 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/message.hpp"
+#include "caf/type_id.hpp"
+
+namespace caf::detail {
+
+/// Maps message types to key functions for conflating messages, i.e., a new
+/// message replaces a pending message of the same type with the same key.
+/// Rules only apply to messages that consist of a single element.
+class CAF_CORE_EXPORT conflation_rules {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Computes and compares keys for messages of a single type.
+  class CAF_CORE_EXPORT rule {
+  public:
+    virtual ~rule();
+
+    /// Returns the hash value for the key of `x`.
+    virtual size_t hash(const message& x) const = 0;
+
+    /// Checks whether `x` and `y` have the same key.
+    virtual bool equal(const message& x, const message& y) const = 0;
+  };
+
+  using rule_ptr = std::unique_ptr<rule>;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether this set contains no rules.
+  bool empty() const noexcept {
+    return rules_.empty();
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a rule for messages that consist of a single `T`. The function
+  /// object `f` returns the key for a `T`. Keys must be equality comparable
+  /// and hashable via `std::hash`. Replaces any previous rule for `T`.
+  template <class T, class F>
+  void add(F f) {
+    add(type_id_v<T>, std::make_unique<rule_impl<T, F>>(std::move(f)));
+  }
+
+  /// Adds `ptr` as the rule for messages that consist of a single `type`.
+  void add(type_id_t type, rule_ptr ptr);
+
+  // -- lookup -----------------------------------------------------------------
+
+  /// Returns the rule for `x` or `nullptr` if `x` does not consist of a
+  /// single element with a registered type.
+  const rule* find(const message& x) const noexcept;
+
+private:
+  template <class T, class F>
+  class rule_impl final : public rule {
+  public:
+    using key_type = std::decay_t<decltype(
+      std::declval<const F&>()(std::declval<const T&>()))>;
+
+    explicit rule_impl(F f) : f_(std::move(f)) {
+      // nop
+    }
+
+    size_t hash(const message& x) const override {
+      std::hash<key_type> h;
+      return h(f_(x.get_as<T>(0)));
+    }
+
+    bool equal(const message& x, const message& y) const override {
+      return f_(x.get_as<T>(0)) == f_(y.get_as<T>(0));
+    }
+
+  private:
+    F f_;
+  };
+
+  std::vector<std::pair<type_id_t, rule_ptr>> rules_;
+};
+
+} // namespace caf::detail
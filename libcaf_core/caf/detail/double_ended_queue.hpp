@@ -6,9 +6,12 @@
 
 #include "caf/config.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <thread>
 
 // GCC hack
@@ -183,6 +186,40 @@ public:
     return result;
   }
 
+  // acquires both locks, dequeues up to half of the elements (at most
+  // `max_count`) from the tail and appends them to `out` in the order
+  // `take_tail` would return them, returns the number of dequeued elements
+  template <class Container>
+  size_type take_tail_batch(size_type max_count, Container& out) {
+    node* first = nullptr;
+    { // lifetime scope of guards
+      lock_guard guard1(head_lock_);
+      lock_guard guard2(tail_lock_);
+      size_type size = 0;
+      for (auto i = head_.load()->next.load(); i != nullptr; i = i->next)
+        ++size;
+      auto n = std::min(max_count, (size + 1) / 2);
+      if (n == 0)
+        return 0;
+      // cut the list after its first `size - n` elements
+      auto pred = head_.load();
+      for (size_type i = 0; i < size - n; ++i)
+        pred = pred->next;
+      first = pred->next;
+      pred->next = nullptr;
+      tail_ = pred;
+    }
+    auto pos = out.size();
+    while (first != nullptr) {
+      unique_node_ptr tmp{first};
+      first = tmp->next;
+      out.push_back(tmp->value);
+    }
+    // take_tail returns the last element first
+    std::reverse(out.begin() + pos, out.end());
+    return out.size() - pos;
+  }
+
   // does not lock
   bool empty() const {
     // atomically compares first and last pointer without locks
@@ -0,0 +1,133 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace caf::detail {
+
+/// A condition variable for lock-free data structures. Waiters announce their
+/// intent with `prepare_wait`, re-check their condition, and then either call
+/// `cancel_wait` or block via `wait`. Notifiers only touch the mutex if at
+/// least one thread announced its intent to wait, i.e., `notify_one` is a
+/// single atomic load on the fast path.
+///
+/// Usage on the consumer side:
+///
+/// ~~~
+/// auto key = ec.prepare_wait();
+/// if (has_work())
+///   ec.cancel_wait();
+/// else
+///   ec.wait(key);
+/// ~~~
+///
+/// Producers make work available first and then call `notify_one`.
+class eventcount {
+public:
+  using key_type = uint32_t;
+
+  eventcount() : state_(0) {
+    // nop
+  }
+
+  eventcount(const eventcount&) = delete;
+
+  eventcount& operator=(const eventcount&) = delete;
+
+  /// Announces the intent to wait and returns a key for `wait`.
+  key_type prepare_wait() noexcept {
+    auto prev = state_.fetch_add(1, std::memory_order_seq_cst);
+    return static_cast<key_type>(prev >> epoch_shift);
+  }
+
+  /// Withdraws a previous call to `prepare_wait`.
+  void cancel_wait() noexcept {
+    state_.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /// Blocks until another thread calls `notify_one` or `notify_all` after the
+  /// call to `prepare_wait` that returned `key`.
+  void wait(key_type key) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.wait(guard, [this, key] { return epoch() != key; });
+    state_.fetch_sub(1, std::memory_order_seq_cst);
+  }
+
+  /// Blocks until another thread calls `notify_one` or `notify_all` after the
+  /// call to `prepare_wait` that returned `key` or until `rel_timeout`
+  /// expires.
+  /// @returns `true` if the calling thread received a notification, `false`
+  ///          on timeout.
+  template <class Rep, class Period>
+  bool wait_for(key_type key,
+                const std::chrono::duration<Rep, Period>& rel_timeout) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto result = cv_.wait_for(guard, rel_timeout,
+                               [this, key] { return epoch() != key; });
+    state_.fetch_sub(1, std::memory_order_seq_cst);
+    return result;
+  }
+
+  /// Wakes up one waiting thread, if any.
+  void notify_one() {
+    if (advance_epoch()) {
+      // Acquiring the mutex prevents the wakeup from getting lost if the
+      // waiter checked its predicate but did not block on `cv_` yet.
+      { std::lock_guard<std::mutex> guard{mtx_}; }
+      cv_.notify_one();
+    }
+  }
+
+  /// Wakes up all waiting threads.
+  void notify_all() {
+    if (advance_epoch()) {
+      { std::lock_guard<std::mutex> guard{mtx_}; }
+      cv_.notify_all();
+    }
+  }
+
+  /// Returns the number of threads that called `prepare_wait` without calling
+  /// `cancel_wait` or returning from `wait` yet.
+  size_t num_waiters() const noexcept {
+    return static_cast<size_t>(state_.load() & waiters_mask);
+  }
+
+private:
+  static constexpr uint64_t epoch_shift = 32;
+
+  static constexpr uint64_t waiters_mask = (uint64_t{1} << epoch_shift) - 1;
+
+  key_type epoch() const noexcept {
+    return static_cast<key_type>(state_.load(std::memory_order_seq_cst)
+                                 >> epoch_shift);
+  }
+
+  // Bumps the epoch if there are waiters. Returns whether any thread waits.
+  bool advance_epoch() noexcept {
+    // Order the producer's write to the data structure before checking for
+    // waiters. Pairs with the RMW operation in `prepare_wait`.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto state = state_.load(std::memory_order_relaxed);
+    if ((state & waiters_mask) == 0)
+      return false;
+    state_.fetch_add(uint64_t{1} << epoch_shift, std::memory_order_seq_cst);
+    return true;
+  }
+
+  // Stores the epoch in the upper 32 bits and the number of waiters in the
+  // lower 32 bits.
+  std::atomic<uint64_t> state_;
+
+  std::mutex mtx_;
+
+  std::condition_variable cv_;
+};
+
+} // namespace caf::detail
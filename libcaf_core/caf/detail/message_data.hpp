@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <new>
 
@@ -13,6 +14,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/implicit_conversions.hpp"
 #include "caf/detail/padded_size.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/fwd.hpp"
 #include "caf/type_id_list.hpp"
 
@@ -43,12 +45,32 @@ public:
   /// Constructs the message data object *without* constructing any element.
   explicit message_data(type_id_list types) noexcept;
 
+  /// Constructs the message data object *without* constructing any element.
+  /// When setting `embedded`, the object lives in the memory of another object
+  /// (usually a @ref mailbox_element) and does not release its memory when
+  /// its reference count drops to zero.
+  message_data(type_id_list types, bool embedded) noexcept;
+
   ~message_data() noexcept;
 
   message_data* copy() const;
 
   static intrusive_ptr<message_data> make_uninitialized(type_id_list types);
 
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates memory for a message data object with `storage_size` bytes for
+  /// its elements. Uses the @ref slab_allocator if CAF was built with
+  /// `CAF_ENABLE_SLAB_ALLOCATOR` and `malloc` otherwise.
+  /// @returns a pointer to uninitialized memory or `nullptr` on error.
+  static void* allocate(size_t storage_size) noexcept {
+#ifdef CAF_ENABLE_SLAB_ALLOCATOR
+    return slab_allocator::allocate(sizeof(message_data) + storage_size);
+#else
+    return malloc(sizeof(message_data) + storage_size);
+#endif
+  }
+
   // -- reference counting -----------------------------------------------------
 
   /// Increases reference count by one.
@@ -60,8 +82,18 @@ public:
   /// reference count drops to zero.
   void deref() noexcept {
     if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      if (embedded_) {
+        this->~message_data();
+        return;
+      }
+#ifdef CAF_ENABLE_SLAB_ALLOCATOR
+      auto size = sizeof(message_data) + types_.data_size();
+      this->~message_data();
+      slab_allocator::deallocate(this, size);
+#else
       this->~message_data();
       free(const_cast<message_data*>(this));
+#endif
     }
   }
 
@@ -77,6 +109,13 @@ public:
     return rc_.load();
   }
 
+  /// Queries whether this object lives in the memory of another object. A
+  /// @ref message must not share embedded data, since it may outlive its
+  /// storage.
+  bool embedded() const noexcept {
+    return embedded_;
+  }
+
   /// Returns the memory region for storing the message elements.
   byte* storage() noexcept {
     return storage_;
@@ -182,8 +221,9 @@ private:
 
   mutable std::atomic<size_t> rc_;
   type_id_list types_;
-  size_t constructed_elements_;
-  byte storage_[];
+  uint32_t constructed_elements_;
+  bool embedded_;
+  alignas(size_t) byte storage_[];
 };
 
 // -- related non-members ------------------------------------------------------
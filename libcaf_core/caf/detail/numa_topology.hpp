@@ -0,0 +1,70 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/optional.hpp"
+#include "caf/string_view.hpp"
+
+namespace caf::detail {
+
+/// Maps CPUs to NUMA nodes.
+class CAF_CORE_EXPORT numa_topology {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// A single NUMA node and its CPUs.
+  struct node {
+    /// ID of the node as reported by the OS.
+    size_t id;
+
+    /// CPUs belonging to this node.
+    std::vector<int> cpus;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  numa_topology() = default;
+
+  explicit numa_topology(std::vector<node> nodes);
+
+  // -- factories --------------------------------------------------------------
+
+  /// Reads the topology of this machine from `/sys/devices/system/node`.
+  /// Falls back to a single node with all CPUs if the OS provides no NUMA
+  /// information.
+  static numa_topology load();
+
+  /// Reads the topology from the sysfs node directory at `path`.
+  /// @returns `none` if `path` contains no readable topology information.
+  static optional<numa_topology> load(const std::string& path);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns all NUMA nodes.
+  const std::vector<node>& nodes() const noexcept {
+    return nodes_;
+  }
+
+  /// Returns all CPUs, ordered by NUMA node.
+  std::vector<int> cpus() const;
+
+  /// Returns the ID of the NUMA node `cpu` belongs to or `none` if `cpu` is
+  /// unknown.
+  optional<size_t> node_of(int cpu) const noexcept;
+
+private:
+  std::vector<node> nodes_;
+};
+
+/// Parses a CPU list in the format used by Linux, e.g., `0-3,8,10-11`.
+/// @returns the sorted list of CPUs or `none` if `str` is malformed.
+CAF_CORE_EXPORT optional<std::vector<int>> parse_cpu_list(string_view str);
+
+} // namespace caf::detail
@@ -0,0 +1,16 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// Binds the calling thread to `cpu`. Not supported on all platforms (no-op on
+/// platforms other than Linux).
+/// @returns `true` if the OS accepted the new affinity, `false` otherwise.
+CAF_CORE_EXPORT bool set_thread_affinity(int cpu);
+
+} // namespace caf::detail
@@ -0,0 +1,76 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+
+#include "caf/detail/core_export.hpp"
+
+namespace caf::detail {
+
+/// A memory allocator for small, short-lived objects such as mailbox elements
+/// and message contents. Each thread allocates blocks from its own set of
+/// slabs without any synchronization. Blocks may get released by any thread:
+/// freeing a block on another thread pushes it to a lock-free list of the
+/// owning thread, which picks up the block again on its next allocation. When
+/// a thread exits, the next thread that allocates memory adopts its slabs.
+///
+/// Requests that exceed `max_block_size` go to `malloc`. The allocator never
+/// returns slabs to the system.
+class CAF_CORE_EXPORT slab_allocator {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Size and alignment of a single slab.
+  static constexpr size_t slab_size = 64 * 1024;
+
+  /// Size of the smallest size class.
+  static constexpr size_t min_block_size = 32;
+
+  /// Size of the largest size class.
+  static constexpr size_t max_block_size = 256;
+
+  /// Number of size classes, each doubling the block size of its predecessor.
+  static constexpr size_t num_size_classes = 4;
+
+  // -- member types -----------------------------------------------------------
+
+  /// Counts allocations over all threads.
+  struct statistics {
+    /// Number of allocations served by the allocator.
+    size_t allocations;
+
+    /// Number of allocations that went to the system allocator, i.e., new
+    /// slabs plus requests that exceed `max_block_size`.
+    size_t system_allocations;
+  };
+
+  // -- allocation -------------------------------------------------------------
+
+  /// Returns a memory block for at least `size` bytes, aligned to
+  /// `alignof(std::max_align_t)`, or `nullptr` if the system is out of memory.
+  static void* allocate(size_t size) noexcept;
+
+  /// Releases a memory block that `allocate(size)` has returned.
+  static void deallocate(void* ptr, size_t size) noexcept;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns a snapshot of the allocation counters.
+  static statistics stats() noexcept;
+
+  /// Returns the size class for a request of `size` bytes.
+  /// @pre `size <= max_block_size`
+  static constexpr size_t size_class(size_t size) noexcept {
+    return size <= 32 ? 0 : size <= 64 ? 1 : size <= 128 ? 2 : 3;
+  }
+
+  /// Returns the block size of size class `index`.
+  static constexpr size_t block_size(size_t index) noexcept {
+    return min_block_size << index;
+  }
+};
+
+} // namespace caf::detail
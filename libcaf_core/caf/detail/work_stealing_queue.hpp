@@ -0,0 +1,168 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "caf/config.hpp"
+#include "caf/detail/chase_lev_deque.hpp"
+
+namespace caf::detail {
+
+/// Job queue of a work-stealing worker. Offers the same interface as
+/// `double_ended_queue`, but keeps jobs of the owner in a lock-free
+/// `chase_lev_deque`. Since the Chase-Lev algorithm only allows the owner to
+/// push, jobs from other threads go to an injection buffer first. The owner
+/// moves them into its deque once it runs out of local work. Neither path
+/// allocates per element: both the deque and the injection buffer retain their
+/// capacity.
+template <class T>
+class work_stealing_queue {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using pointer = value_type*;
+
+  work_stealing_queue() : injected_(0) {
+    lock_.clear();
+  }
+
+  work_stealing_queue(const work_stealing_queue&) = delete;
+
+  work_stealing_queue& operator=(const work_stealing_queue&) = delete;
+
+  /// Enqueues `value` at the end of the queue. Safe to call from any thread.
+  void append(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    lock_guard guard{lock_};
+    inbox_.push_back(value);
+    injected_.fetch_add(1, std::memory_order_release);
+  }
+
+  /// Enqueues `value` as the next element for `take_head`.
+  /// @warning Must only be called by the owner.
+  void prepend(pointer value) {
+    deque_.push_bottom(value);
+  }
+
+  /// Dequeues the next element for the owner or returns `nullptr` if the
+  /// queue is empty.
+  /// @warning Must only be called by the owner.
+  pointer take_head() {
+    if (auto result = deque_.take_bottom())
+      return result;
+    if (injected_.load(std::memory_order_acquire) == 0)
+      return nullptr;
+    { // Lifetime scope of guard.
+      lock_guard guard{lock_};
+      using std::swap;
+      swap(inbox_, cache_);
+      injected_.store(0, std::memory_order_release);
+    }
+    if (cache_.empty())
+      return nullptr;
+    // Push in reverse order to keep FIFO order for the owner, which also
+    // leaves the youngest elements on top for thieves.
+    auto result = cache_.front();
+    for (auto i = cache_.size() - 1; i > 0; --i)
+      deque_.push_bottom(cache_[i]);
+    cache_.clear();
+    return result;
+  }
+
+  /// Dequeues an element for a thief or returns `nullptr` if the queue is
+  /// empty. Prefers the oldest element of the deque and falls back to the
+  /// injection buffer. Safe to call from any thread.
+  pointer take_tail() {
+    if (auto result = deque_.take_top())
+      return result;
+    if (injected_.load(std::memory_order_acquire) == 0)
+      return nullptr;
+    lock_guard guard{lock_};
+    if (inbox_.empty())
+      return nullptr;
+    auto result = inbox_.back();
+    inbox_.pop_back();
+    injected_.fetch_sub(1, std::memory_order_release);
+    return result;
+  }
+
+  /// Dequeues up to half of the elements, but no more than `max_count`, for a
+  /// thief and appends them to `out` in the order `take_tail` would return
+  /// them. Always dequeues at least one element unless the queue is empty.
+  /// Safe to call from any thread.
+  /// @returns the number of elements added to `out`.
+  template <class Container>
+  size_type take_tail_batch(size_type max_count, Container& out) {
+    auto n = std::min(max_count, (size() + 1) / 2);
+    size_type result = 0;
+    for (; result < n; ++result) {
+      auto x = deque_.take_top();
+      if (x == nullptr)
+        break;
+      out.emplace_back(x);
+    }
+    if (result == n || injected_.load(std::memory_order_acquire) == 0)
+      return result;
+    // Fall back to the injection buffer, acquiring its lock only once.
+    lock_guard guard{lock_};
+    auto k = std::min(n - result, inbox_.size());
+    for (size_type i = 0; i < k; ++i) {
+      out.emplace_back(inbox_.back());
+      inbox_.pop_back();
+    }
+    injected_.fetch_sub(k, std::memory_order_release);
+    return result + k;
+  }
+
+  /// Returns an estimate of the number of elements in the queue. Safe to call
+  /// from any thread.
+  size_type size() const noexcept {
+    return deque_.size() + injected_.load(std::memory_order_acquire);
+  }
+
+  /// Checks whether the queue is (approximately) empty. Safe to call from any
+  /// thread.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+private:
+  class lock_guard {
+  public:
+    explicit lock_guard(std::atomic_flag& lock) : lock_(lock) {
+      while (lock.test_and_set(std::memory_order_acquire))
+        std::this_thread::yield();
+    }
+
+    ~lock_guard() {
+      lock_.clear(std::memory_order_release);
+    }
+
+  private:
+    std::atomic_flag& lock_;
+  };
+
+  // Jobs of the owner, exposed to thieves.
+  chase_lev_deque<value_type> deque_;
+
+  // Number of elements in `inbox_`.
+  std::atomic<size_type> injected_;
+
+  // Protects `inbox_`.
+  std::atomic_flag lock_;
+
+  // Jobs from other threads, guarded by `lock_`.
+  std::vector<pointer> inbox_;
+
+  // Swapped with `inbox_` by the owner to drain it without allocating.
+  std::vector<pointer> cache_;
+};
+
+} // namespace caf::detail
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "caf/fwd.hpp"
 
 #include "caf/config.hpp"
@@ -47,9 +49,27 @@ public:
     proxies_ = ptr;
   }
 
+  /// Returns the scheduler domain this unit belongs to or `nullptr` if the
+  /// unit belongs to the default scheduler.
+  scheduler::abstract_coordinator* scheduler_domain() const noexcept {
+    return scheduler_domain_;
+  }
+
+  /// Returns the number of messages actors have processed on this unit.
+  size_t processed_messages() const noexcept {
+    return processed_messages_;
+  }
+
+  /// Adds `n` to the number of processed messages.
+  void count_processed_messages(size_t n) noexcept {
+    processed_messages_ += n;
+  }
+
 protected:
   actor_system* system_ = nullptr;
   proxy_registry* proxies_ = nullptr;
+  scheduler::abstract_coordinator* scheduler_domain_ = nullptr;
+  size_t processed_messages_ = 0;
 };
 
 } // namespace caf
@@ -182,6 +182,7 @@ config_option make_config_option(T& storage, string_view category,
 enum class byte : uint8_t;
 enum class exit_reason : uint8_t;
 enum class invoke_message_result;
+enum class mailbox_overflow_policy : uint8_t;
 enum class pec : uint8_t;
 enum class sec : uint8_t;
 enum class stream_priority : uint8_t;
@@ -327,6 +328,7 @@ namespace scheduler {
 class abstract_worker;
 class test_coordinator;
 class abstract_coordinator;
+class sampling_profiler;
 
 } // namespace scheduler
 
@@ -0,0 +1,259 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "caf/config.hpp"
+
+#include "caf/intrusive/drr_cached_queue.hpp"
+#include "caf/intrusive/new_round_result.hpp"
+#include "caf/intrusive/task_result.hpp"
+
+namespace caf::intrusive {
+
+/// A cached Deficit Round Robin queue that keeps at most one pending element
+/// per key. A new element with the same key as a pending element replaces the
+/// content of the pending element instead of queueing behind it. The queue
+/// keeps superseded elements until the owner calls `drop_superseded`, e.g., for
+/// updating metrics.
+///
+/// In addition to the interface of @ref drr_cached_queue, the policy provides:
+///
+/// ~~~
+/// size_t hash_key(const value_type& x) const;
+/// bool equal_keys(const value_type& x, const value_type& y) const;
+/// static void supersede(value_type& pending, value_type& x);
+/// ~~~
+template <class Policy>
+class drr_conflating_queue {
+public:
+  // -- member types ----------------------------------------------------------
+
+  using policy_type = Policy;
+
+  using queue_type = drr_cached_queue<policy_type>;
+
+  using value_type = typename policy_type::mapped_type;
+
+  using node_type = typename value_type::node_type;
+
+  using node_pointer = node_type*;
+
+  using pointer = value_type*;
+
+  using unique_pointer = typename policy_type::unique_pointer;
+
+  using deficit_type = typename policy_type::deficit_type;
+
+  using task_size_type = typename policy_type::task_size_type;
+
+  using cache_type = typename queue_type::cache_type;
+
+  // -- constructors, destructors, and assignment operators -------------------
+
+  drr_conflating_queue(policy_type p) : queue_(std::move(p)) {
+    // nop
+  }
+
+  drr_conflating_queue(drr_conflating_queue&&) = default;
+
+  drr_conflating_queue& operator=(drr_conflating_queue&&) = default;
+
+  // -- properties ------------------------------------------------------------
+
+  policy_type& policy() noexcept {
+    return queue_.policy();
+  }
+
+  const policy_type& policy() const noexcept {
+    return queue_.policy();
+  }
+
+  deficit_type deficit() const {
+    return queue_.deficit();
+  }
+
+  task_size_type total_task_size() const {
+    return queue_.total_task_size();
+  }
+
+  bool empty() const noexcept {
+    return queue_.empty();
+  }
+
+  pointer peek() noexcept {
+    return queue_.peek();
+  }
+
+  template <class F>
+  void peek_all(F f) const {
+    queue_.peek_all(f);
+  }
+
+  /// Returns the number of elements that newer elements have replaced since
+  /// the last call to `drop_superseded`.
+  size_t superseded() const noexcept {
+    return superseded_.size();
+  }
+
+  // -- modifiers -------------------------------------------------------------
+
+  void clear() {
+    index_.clear();
+    superseded_.clear();
+    queue_.clear();
+  }
+
+  void inc_deficit(deficit_type x) noexcept {
+    queue_.inc_deficit(x);
+  }
+
+  void flush_cache() noexcept {
+    queue_.flush_cache();
+  }
+
+  template <class T>
+  void inc_total_task_size(T&& x) noexcept {
+    queue_.inc_total_task_size(std::forward<T>(x));
+  }
+
+  template <class T>
+  void dec_total_task_size(T&& x) noexcept {
+    queue_.dec_total_task_size(std::forward<T>(x));
+  }
+
+  unique_pointer take_front() noexcept {
+    auto result = queue_.take_front();
+    if (result != nullptr)
+      erase(policy().hash_key(*result), result.get());
+    return result;
+  }
+
+  /// Passes each superseded element to `f` before deleting it.
+  template <class F>
+  void drop_superseded(F f) {
+    for (auto& ptr : superseded_)
+      f(*ptr);
+    superseded_.clear();
+  }
+
+  template <class F>
+  bool consume(F& f) {
+    return new_round(0, f).consumed_items > 0;
+  }
+
+  template <class F>
+  new_round_result new_round(deficit_type quantum, F& consumer) {
+    auto f = [this, &consumer](value_type& x) {
+      // Remove `x` from the index before running the consumer. Otherwise, a
+      // new element could replace the content of an element in use.
+      auto key = policy().hash_key(x);
+      auto indexed = erase(key, &x);
+      auto res = consumer(x);
+      if (res == task_result::skip && indexed)
+        index_.emplace(key, entry{&x, generation_});
+      return res;
+    };
+    return queue_.new_round(quantum, f);
+  }
+
+  cache_type& cache() noexcept {
+    return queue_.cache();
+  }
+
+  // -- insertion -------------------------------------------------------------
+
+  bool push_back(pointer ptr) noexcept {
+    auto key = policy().hash_key(*ptr);
+    if (auto pending = find(key, *ptr)) {
+      policy_type::supersede(*pending->ptr, *ptr);
+      superseded_.emplace_back(ptr);
+      return true;
+    }
+    index_.emplace(key, entry{ptr, generation_});
+    return queue_.push_back(ptr);
+  }
+
+  bool push_back(unique_pointer ptr) noexcept {
+    return push_back(ptr.release());
+  }
+
+  template <class... Ts>
+  bool emplace_back(Ts&&... xs) {
+    return push_back(new value_type(std::forward<Ts>(xs)...));
+  }
+
+  /// Appends elements in reverse order, i.e., the first element after calling
+  /// `stop_lifo_append` is the most recent one. Hence, an element with the
+  /// same key as an element from the same sequence is always older.
+  void lifo_append(node_pointer ptr) {
+    auto x = static_cast<pointer>(ptr);
+    auto key = policy().hash_key(*x);
+    if (auto pending = find(key, *x)) {
+      if (pending->generation != generation_) {
+        policy_type::supersede(*pending->ptr, *x);
+        pending->generation = generation_;
+      }
+      superseded_.emplace_back(x);
+      return;
+    }
+    index_.emplace(key, entry{x, generation_});
+    queue_.lifo_append(ptr);
+  }
+
+  void stop_lifo_append() {
+    queue_.stop_lifo_append();
+    ++generation_;
+  }
+
+private:
+  // -- member types ----------------------------------------------------------
+
+  struct entry {
+    pointer ptr;
+    uint64_t generation;
+  };
+
+  // -- utility functions -----------------------------------------------------
+
+  entry* find(size_t key, const value_type& x) {
+    auto [first, last] = index_.equal_range(key);
+    for (auto i = first; i != last; ++i)
+      if (policy().equal_keys(*i->second.ptr, x))
+        return &i->second;
+    return nullptr;
+  }
+
+  bool erase(size_t key, pointer ptr) {
+    auto [first, last] = index_.equal_range(key);
+    for (auto i = first; i != last; ++i) {
+      if (i->second.ptr == ptr) {
+        index_.erase(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // -- member variables ------------------------------------------------------
+
+  /// Stores pending elements.
+  queue_type queue_;
+
+  /// Maps the hash of the key of each pending element to the element.
+  std::unordered_multimap<size_t, entry> index_;
+
+  /// Stores elements that newer elements have replaced.
+  std::vector<unique_pointer> superseded_;
+
+  /// Identifies the current sequence of `lifo_append` calls.
+  uint64_t generation_ = 0;
+};
+
+} // namespace caf::intrusive
@@ -0,0 +1,370 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "caf/config.hpp"
+
+#include "caf/intrusive/new_round_result.hpp"
+#include "caf/intrusive/task_queue.hpp"
+#include "caf/intrusive/task_result.hpp"
+
+namespace caf::intrusive {
+
+/// A Deficit Round Robin queue with an indexed stash for skipped elements.
+/// Like @ref drr_cached_queue, the queue parks skipped elements and retries
+/// them after the consumer accepts an element. However, the policy may assign
+/// a key to a skipped element. The queue only retries keyed elements after the
+/// stash epoch of the policy changed and only if the policy allows retrying
+/// elements with that key. This avoids rescanning elements that the consumer
+/// would skip again.
+///
+/// In addition to the interface of @ref drr_cached_queue, the policy provides:
+///
+/// ~~~
+/// using stash_key_type = ...;
+/// stash_key_type stash_key(const value_type& x) const;
+/// size_t stash_epoch() const;
+/// bool retry(const stash_key_type& key) const;
+/// ~~~
+///
+/// Keys convert to `false` for elements that the queue must retry after each
+/// consumed element.
+template <class Policy>
+class drr_stashing_queue {
+public:
+  // -- member types ----------------------------------------------------------
+
+  using policy_type = Policy;
+
+  using value_type = typename policy_type::mapped_type;
+
+  using node_type = typename value_type::node_type;
+
+  using node_pointer = node_type*;
+
+  using pointer = value_type*;
+
+  using unique_pointer = typename policy_type::unique_pointer;
+
+  using deficit_type = typename policy_type::deficit_type;
+
+  using task_size_type = typename policy_type::task_size_type;
+
+  using stash_key_type = typename policy_type::stash_key_type;
+
+  using list_type = task_queue<policy_type>;
+
+  // -- constructors, destructors, and assignment operators -------------------
+
+  drr_stashing_queue(policy_type p) : list_(std::move(p)) {
+    // nop
+  }
+
+  drr_stashing_queue(drr_stashing_queue&&) = default;
+
+  drr_stashing_queue& operator=(drr_stashing_queue&&) = default;
+
+  // -- observers -------------------------------------------------------------
+
+  /// Returns the policy object.
+  policy_type& policy() noexcept {
+    return list_.policy();
+  }
+
+  /// Returns the policy object.
+  const policy_type& policy() const noexcept {
+    return list_.policy();
+  }
+
+  deficit_type deficit() const {
+    return deficit_;
+  }
+
+  /// Returns the accumulated size of all stored tasks in the list, i.e., tasks
+  /// that are not in the stash.
+  task_size_type total_task_size() const {
+    return list_.total_task_size();
+  }
+
+  /// Returns whether the queue has no unstashed tasks.
+  bool empty() const noexcept {
+    return total_task_size() == 0;
+  }
+
+  /// Peeks at the first element of the list.
+  pointer peek() noexcept {
+    return list_.peek();
+  }
+
+  /// Applies `f` to each element in the queue, excluding stashed elements.
+  template <class F>
+  void peek_all(F f) const {
+    list_.peek_all(f);
+  }
+
+  /// Returns the number of stashed elements.
+  size_t stashed() const noexcept {
+    return cache_.size() + indexed_;
+  }
+
+  /// Returns the number of stashed elements that the queue moved back to the
+  /// list since the last call and resets the counter.
+  size_t take_retried() noexcept {
+    return std::exchange(retried_, 0);
+  }
+
+  // -- modifiers -------------------------------------------------------------
+
+  /// Removes all elements from the queue.
+  void clear() {
+    list_.clear();
+    cache_.clear();
+    index_.clear();
+    indexed_ = 0;
+  }
+
+  void inc_deficit(deficit_type x) noexcept {
+    if (!list_.empty())
+      deficit_ += x;
+  }
+
+  /// Moves all stashed elements back to the list, regardless of their key.
+  void flush_cache() {
+    if (stashed() == 0)
+      return;
+    for (auto& kvp : index_)
+      std::move(kvp.second.begin(), kvp.second.end(),
+                std::back_inserter(cache_));
+    index_.clear();
+    indexed_ = 0;
+    restore(cache_, true);
+  }
+
+  /// @private
+  template <class T>
+  void inc_total_task_size(T&& x) noexcept {
+    list_.inc_total_task_size(std::forward<T>(x));
+  }
+
+  /// @private
+  template <class T>
+  void dec_total_task_size(T&& x) noexcept {
+    list_.dec_total_task_size(std::forward<T>(x));
+  }
+
+  /// Takes the first element out of the queue if the deficit allows it and
+  /// returns the element.
+  /// @private
+  unique_pointer next() noexcept {
+    return list_.next(deficit_);
+  }
+
+  /// Takes the first element out of the queue (after flushing the stash) and
+  /// returns it, ignoring the deficit count.
+  unique_pointer take_front() {
+    flush_cache();
+    if (!list_.empty()) {
+      // Don't modify the deficit counter.
+      auto dummy_deficit = std::numeric_limits<deficit_type>::max();
+      return list_.next(dummy_deficit);
+    }
+    return nullptr;
+  }
+
+  /// Consumes items from the queue until the queue is empty, there is not
+  /// enough deficit to dequeue the next task or the consumer returns `stop`.
+  /// @returns `true` if `f` consumed at least one item.
+  template <class F>
+  bool consume(F& f) {
+    return new_round(0, f).consumed_items > 0;
+  }
+
+  /// Run a new round with `quantum`, dispatching all tasks to `consumer`.
+  template <class F>
+  new_round_result new_round(deficit_type quantum, F& consumer) {
+    if (list_.empty())
+      return {0, false};
+    deficit_ += quantum;
+    auto ptr = next();
+    if (ptr == nullptr)
+      return {0, false};
+    size_t consumed = 0;
+    do {
+      auto consumer_res = consumer(*ptr);
+      switch (consumer_res) {
+        case task_result::skip:
+          // Fix deficit counter since we didn't actually use it.
+          deficit_ += policy().task_size(*ptr);
+          stash(std::move(ptr));
+          if (list_.empty()) {
+            deficit_ = 0;
+            return {consumed, false};
+          }
+          break;
+        case task_result::resume:
+          ++consumed;
+          retry_stashed();
+          if (list_.empty()) {
+            deficit_ = 0;
+            return {consumed, false};
+          }
+          break;
+        default:
+          ++consumed;
+          retry_stashed();
+          if (list_.empty())
+            deficit_ = 0;
+          return {consumed, consumer_res == task_result::stop_all};
+      }
+      ptr = next();
+    } while (ptr != nullptr);
+    return {consumed, false};
+  }
+
+  list_type& items() noexcept {
+    return list_;
+  }
+
+  // -- insertion --------------------------------------------------------------
+
+  /// Appends `ptr` to the queue.
+  /// @pre `ptr != nullptr`
+  bool push_back(pointer ptr) noexcept {
+    return list_.push_back(ptr);
+  }
+
+  /// Appends `ptr` to the queue.
+  /// @pre `ptr != nullptr`
+  bool push_back(unique_pointer ptr) noexcept {
+    return push_back(ptr.release());
+  }
+
+  /// Creates a new element from `xs...` and appends it.
+  template <class... Ts>
+  bool emplace_back(Ts&&... xs) {
+    return push_back(new value_type(std::forward<Ts>(xs)...));
+  }
+
+  /// Moves a skipped element to the stash.
+  void stash(unique_pointer ptr) {
+    auto key = policy().stash_key(*ptr);
+    if (!key) {
+      cache_.push_back(stashed_element{seq_++, std::move(ptr)});
+      return;
+    }
+    auto pred = [&key](const auto& kvp) { return kvp.first == key; };
+    auto i = std::find_if(index_.begin(), index_.end(), pred);
+    if (i == index_.end()) {
+      index_.emplace_back(key, stashed_list{});
+      i = index_.end() - 1;
+    }
+    i->second.push_back(stashed_element{seq_++, std::move(ptr)});
+    ++indexed_;
+  }
+
+  /// @private
+  void lifo_append(node_pointer ptr) {
+    list_.lifo_append(ptr);
+  }
+
+  /// @private
+  void stop_lifo_append() {
+    list_.stop_lifo_append();
+  }
+
+private:
+  // -- member types ----------------------------------------------------------
+
+  struct stashed_element {
+    /// Restores the order of elements from different keys.
+    uint64_t seq;
+
+    unique_pointer ptr;
+  };
+
+  using stashed_list = std::vector<stashed_element>;
+
+  // -- utility functions -----------------------------------------------------
+
+  /// Moves unkeyed elements and all keyed elements that the policy allows
+  /// retrying back to the list.
+  void retry_stashed() {
+    auto epoch = policy().stash_epoch();
+    if (epoch == epoch_ || indexed_ == 0) {
+      epoch_ = epoch;
+      restore(cache_, false);
+      return;
+    }
+    epoch_ = epoch;
+    auto merged = false;
+    auto i = index_.begin();
+    while (i != index_.end()) {
+      if (policy().retry(i->first)) {
+        indexed_ -= i->second.size();
+        merged = merged || !cache_.empty();
+        std::move(i->second.begin(), i->second.end(),
+                  std::back_inserter(cache_));
+        i = index_.erase(i);
+      } else {
+        ++i;
+      }
+    }
+    restore(cache_, merged);
+  }
+
+  /// Moves all elements in `xs` to the front of the list, in order of their
+  /// arrival in the stash.
+  void restore(stashed_list& xs, bool sort) {
+    if (xs.empty())
+      return;
+    if (sort) {
+      auto cmp = [](const auto& x, const auto& y) { return x.seq < y.seq; };
+      std::sort(xs.begin(), xs.end(), cmp);
+    }
+    retried_ += xs.size();
+    list_type tmp{policy()};
+    for (auto& x : xs)
+      tmp.push_back(x.ptr.release());
+    xs.clear();
+    list_.prepend(tmp);
+  }
+
+  // -- member variables ------------------------------------------------------
+
+  /// Stores current (unstashed) items.
+  list_type list_;
+
+  /// Stores the deficit on this queue.
+  deficit_type deficit_ = 0;
+
+  /// Stores skipped elements without key. The queue retries them after each
+  /// consumed element.
+  stashed_list cache_;
+
+  /// Stores skipped elements with key, grouped by key. We expect only few
+  /// distinct keys at a time, hence a vector instead of a map.
+  std::vector<std::pair<stash_key_type, stashed_list>> index_;
+
+  /// Stores the number of elements in `index_`.
+  size_t indexed_ = 0;
+
+  /// Stores the stash epoch of the policy at the last retry.
+  size_t epoch_ = 0;
+
+  /// Assigns a sequence number to each stashed element.
+  uint64_t seq_ = 0;
+
+  /// Counts how many stashed elements the queue moved back to the list.
+  size_t retried_ = 0;
+};
+
+} // namespace caf::intrusive
@@ -18,6 +18,7 @@
 
 #include "caf/intrusive/inbox_result.hpp"
 #include "caf/intrusive/lifo_inbox.hpp"
+#include "caf/intrusive/mpsc_inbox.hpp"
 #include "caf/intrusive/new_round_result.hpp"
 
 #include "caf/detail/enqueue_result.hpp"
@@ -25,7 +26,9 @@
 namespace caf::intrusive {
 
 /// A FIFO inbox that combines an efficient thread-safe LIFO inbox with a FIFO
-/// queue for re-ordering incoming messages.
+/// queue for re-ordering incoming messages. When building CAF with
+/// `CAF_ENABLE_MPSC_INBOX`, the inbox uses a thread-safe FIFO queue instead
+/// (see @ref mpsc_inbox) that does not require re-ordering.
 template <class Policy>
 class fifo_inbox {
 public:
@@ -41,6 +44,12 @@ public:
 
   using lifo_inbox_type = lifo_inbox<policy_type>;
 
+#ifdef CAF_ENABLE_MPSC_INBOX
+  using inbox_type = mpsc_inbox<policy_type>;
+#else
+  using inbox_type = lifo_inbox_type;
+#endif
+
   using pointer = value_type*;
 
   using unique_pointer = typename queue_type::unique_pointer;
@@ -80,7 +89,11 @@ public:
 
   /// Appends `ptr` to the inbox.
   inbox_result push_back(pointer ptr) noexcept {
+#ifdef CAF_ENABLE_MPSC_INBOX
+    return inbox_.push_back(ptr);
+#else
     return inbox_.push_front(ptr);
+#endif
   }
 
   /// Appends `ptr` to the inbox.
@@ -93,12 +106,29 @@ public:
     return push_back(new value_type(std::forward<Ts>(xs)...));
   }
 
+  /// Appends the chain `[first, last]` to the inbox with a single atomic
+  /// operation, where following `next` pointers from `first` leads to `last`
+  /// and `last->next == nullptr`. The caller retains ownership of the chain
+  /// if the inbox has been closed.
+  inbox_result push_back_chain(pointer first, pointer last) noexcept {
+#ifdef CAF_ENABLE_MPSC_INBOX
+    return inbox_.push_back_chain(first, last);
+#else
+    // The LIFO inbox stores the most recent element first.
+    reverse_chain(first);
+    auto result = inbox_.push_front_chain(last, first);
+    if (result == inbox_result::queue_closed)
+      reverse_chain(last);
+    return result;
+#endif
+  }
+
   // -- backwards compatibility ------------------------------------------------
 
   /// @cond PRIVATE
 
   detail::enqueue_result enqueue(pointer ptr) noexcept {
-    return static_cast<detail::enqueue_result>(inbox_.push_front(ptr));
+    return static_cast<detail::enqueue_result>(push_back(ptr));
   }
 
   size_t count() noexcept {
@@ -119,6 +149,10 @@ public:
 
   /// Tries to get more items from the inbox.
   bool fetch_more() {
+#ifdef CAF_ENABLE_MPSC_INBOX
+    auto f = [this](pointer x) { queue_.push_back(x); };
+    return inbox_.take_all(f);
+#else
     node_pointer head = inbox_.take_head();
     if (head == nullptr)
       return false;
@@ -129,6 +163,7 @@ public:
     } while (head != nullptr);
     queue_.stop_lifo_append();
     return true;
+#endif
   }
 
   /// Tries to set this queue from `empty` to `blocked`.
@@ -144,9 +179,14 @@ public:
   /// Closes this inbox and moves all elements to the queue.
   /// @warning Call only from the reader (owner).
   void close() {
+#ifdef CAF_ENABLE_MPSC_INBOX
+    auto f = [&](pointer x) { queue_.push_back(x); };
+    inbox_.close(f);
+#else
     auto f = [&](pointer x) { queue_.lifo_append(x); };
     inbox_.close(f);
     queue_.stop_lifo_append();
+#endif
   }
 
   /// Run a new round with `quantum`, dispatching all tasks to `consumer`.
@@ -169,7 +209,11 @@ public:
 
   template <class Mutex, class CondVar>
   bool synchronized_push_back(Mutex& mtx, CondVar& cv, pointer ptr) {
+#ifdef CAF_ENABLE_MPSC_INBOX
+    return inbox_.synchronized_push_back(mtx, cv, ptr);
+#else
     return inbox_.synchronized_push_front(mtx, cv, ptr);
+#endif
   }
 
   template <class Mutex, class CondVar>
@@ -203,10 +247,25 @@ public:
   }
 
 private:
+#ifndef CAF_ENABLE_MPSC_INBOX
+  // -- utility functions ------------------------------------------------------
+
+  /// Reverses the `nullptr`-terminated chain starting at `ptr`.
+  static void reverse_chain(node_pointer ptr) noexcept {
+    node_pointer prev = nullptr;
+    while (ptr != nullptr) {
+      auto next = ptr->next;
+      ptr->next = prev;
+      prev = ptr;
+      ptr = next;
+    }
+  }
+#endif
+
   // -- member variables -------------------------------------------------------
 
-  /// Thread-safe LIFO inbox.
-  lifo_inbox_type inbox_;
+  /// Thread-safe LIFO or FIFO inbox.
+  inbox_type inbox_;
 
   /// User-facing queue that is constantly resupplied from the inbox.
   queue_type queue_;
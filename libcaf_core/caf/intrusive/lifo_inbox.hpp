@@ -71,6 +71,29 @@ public:
     return push_front(x.release());
   }
 
+  /// Tries to enqueue the chain `[first, last]` to the inbox with a single
+  /// atomic operation, where `first` is the most recent element and following
+  /// `next` pointers leads to `last`. Unlike `push_front`, the caller retains
+  /// ownership of all elements if the queue has been closed.
+  /// @threadsafe
+  inbox_result push_front_chain(pointer first, pointer last) noexcept {
+    CAF_ASSERT(first != nullptr);
+    CAF_ASSERT(last != nullptr);
+    pointer e = stack_.load();
+    auto eof = stack_closed_tag();
+    auto blk = reader_blocked_tag();
+    while (e != eof) {
+      // A tag is never part of a non-empty list.
+      last->next = e != blk ? e : nullptr;
+      if (stack_.compare_exchange_strong(e, first))
+        return e == reader_blocked_tag() ? inbox_result::unblocked_reader
+                                         : inbox_result::success;
+      // Continue with new value of `e`.
+    }
+    last->next = nullptr;
+    return inbox_result::queue_closed;
+  }
+
   /// Tries to enqueue a new element to the mailbox.
   /// @threadsafe
   template <class... Ts>
@@ -0,0 +1,371 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "caf/config.hpp"
+
+#include "caf/intrusive/inbox_result.hpp"
+
+namespace caf::intrusive {
+
+/// An intrusive, thread-safe FIFO queue implementation for a single reader
+/// with any number of writers, based on the MPSC queue by Dmitry Vyukov.
+///
+/// Writers atomically replace the head (the most recent element) with their
+/// new element and only then link the previous head to it. Hence, the reader
+/// receives elements in FIFO order without reversing a list first. Unlike the
+/// original algorithm, the head also encodes whether the queue is empty, the
+/// reader is blocked, or the queue is closed, using the same tags as
+/// @ref lifo_inbox.
+template <class Policy>
+class mpsc_inbox {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using policy_type = Policy;
+
+  using value_type = typename policy_type::mapped_type;
+
+  using pointer = value_type*;
+
+  using node_type = typename value_type::node_type;
+
+  using node_pointer = node_type*;
+
+  using unique_pointer = typename policy_type::unique_pointer;
+
+  using deleter_type = typename unique_pointer::deleter_type;
+
+  // -- static utility functions -----------------------------------------------
+
+  /// Casts a node type to its value type.
+  static pointer promote(node_pointer ptr) noexcept {
+    return static_cast<pointer>(ptr);
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Tries to enqueue a new element to the inbox.
+  /// @threadsafe
+  inbox_result push_back(pointer new_element) noexcept {
+    CAF_ASSERT(new_element != nullptr);
+    next_of(new_element).store(nullptr, std::memory_order_relaxed);
+    pointer e = head_.load();
+    auto eof = closed_tag();
+    while (e != eof) {
+      if (head_.compare_exchange_weak(e, new_element)) {
+        if (is_empty_or_blocked_tag(e)) {
+          // The reader picks up the first element separately, since there is
+          // no previous element to link to.
+          first_.store(new_element, std::memory_order_release);
+          return e == reader_blocked_tag() ? inbox_result::unblocked_reader
+                                           : inbox_result::success;
+        }
+        // The reader waits for this link before releasing `e`.
+        next_of(e).store(new_element, std::memory_order_release);
+        return inbox_result::success;
+      }
+      // Continue with new value of `e`.
+    }
+    // The queue has been closed, drop messages.
+    deleter_type d;
+    d(new_element);
+    return inbox_result::queue_closed;
+  }
+
+  /// Tries to enqueue a new element to the inbox.
+  /// @threadsafe
+  inbox_result push_back(unique_pointer x) noexcept {
+    return push_back(x.release());
+  }
+
+  /// Tries to enqueue the chain `[first, last]` to the inbox with a single
+  /// atomic operation, where following `next` pointers from `first` leads to
+  /// `last`. Unlike `push_back`, the caller retains ownership of all elements
+  /// if the queue has been closed.
+  /// @threadsafe
+  inbox_result push_back_chain(pointer first, pointer last) noexcept {
+    CAF_ASSERT(first != nullptr);
+    CAF_ASSERT(last != nullptr);
+    next_of(last).store(nullptr, std::memory_order_relaxed);
+    pointer e = head_.load();
+    auto eof = closed_tag();
+    while (e != eof) {
+      if (head_.compare_exchange_weak(e, last)) {
+        if (is_empty_or_blocked_tag(e)) {
+          first_.store(first, std::memory_order_release);
+          return e == reader_blocked_tag() ? inbox_result::unblocked_reader
+                                           : inbox_result::success;
+        }
+        next_of(e).store(first, std::memory_order_release);
+        return inbox_result::success;
+      }
+      // Continue with new value of `e`.
+    }
+    return inbox_result::queue_closed;
+  }
+
+  /// Tries to enqueue a new element to the mailbox.
+  /// @threadsafe
+  template <class... Ts>
+  inbox_result emplace_back(Ts&&... xs) {
+    return push_back(new value_type(std::forward<Ts>(xs)...));
+  }
+
+  /// Removes the oldest element from the queue.
+  /// @returns the oldest element or `nullptr` if the queue is empty, blocked
+  ///          or closed.
+  /// @warning Call only from the reader (owner).
+  pointer pop_front() noexcept {
+    if (tail_ == nullptr) {
+      auto e = head_.load();
+      if (is_empty_or_blocked_tag(e) || e == closed_tag())
+        return nullptr;
+      tail_ = await_first();
+    }
+    auto result = tail_;
+    tail_ = successor(result);
+    return promote(result);
+  }
+
+  /// Removes all elements that were in the queue when calling this function
+  /// and passes them to `f` in FIFO order. Writers may add more elements
+  /// concurrently, but `f` only receives elements up to the most recent
+  /// element at the time of the call.
+  /// @returns `true` if `f` received at least one element, `false` otherwise.
+  /// @warning Call only from the reader (owner).
+  template <class F>
+  bool take_all(F& f) noexcept(noexcept(f(std::declval<pointer>()))) {
+    pointer last = head_.load();
+    // Like lifo_inbox::take_head, fetching from a blocked queue resets it to
+    // empty. Otherwise, the reader would fail to block again.
+    if (last == reader_blocked_tag()
+        && head_.compare_exchange_strong(last, empty_tag()))
+      return false;
+    if (is_empty_or_blocked_tag(last) || last == closed_tag())
+      return false;
+    for (;;) {
+      auto ptr = pop_front();
+      CAF_ASSERT(ptr != nullptr);
+      f(ptr);
+      if (ptr == last)
+        return true;
+    }
+  }
+
+  /// Queries whether this queue is empty.
+  /// @pre `!closed() && !blocked()`
+  bool empty() const noexcept {
+    CAF_ASSERT(!closed());
+    CAF_ASSERT(!blocked());
+    return head_.load() == empty_tag();
+  }
+
+  /// Queries whether this has been closed.
+  bool closed() const noexcept {
+    return head_.load() == closed_tag();
+  }
+
+  /// Queries whether this has been marked as blocked, i.e.,
+  /// the owner of the list is waiting for new data.
+  bool blocked() const noexcept {
+    return head_.load() == reader_blocked_tag();
+  }
+
+  /// Tries to set this queue from `empty` to `blocked`.
+  bool try_block() noexcept {
+    auto e = empty_tag();
+    return head_.compare_exchange_strong(e, reader_blocked_tag());
+  }
+
+  /// Tries to set this queue from `blocked` to `empty`.
+  bool try_unblock() noexcept {
+    auto e = reader_blocked_tag();
+    return head_.compare_exchange_strong(e, empty_tag());
+  }
+
+  /// Closes this queue and deletes all remaining elements.
+  /// @warning Call only from the reader (owner).
+  void close() noexcept {
+    deleter_type d;
+    close(d);
+  }
+
+  /// Closes this queue and applies `f` to each pointer in FIFO order. The
+  /// function object `f` must take ownership of the passed pointer.
+  /// @warning Call only from the reader (owner).
+  template <class F>
+  void close(F& f) noexcept(noexcept(f(std::declval<pointer>()))) {
+    pointer last = head_.exchange(closed_tag());
+    // Must not be called on a closed queue.
+    CAF_ASSERT(last != closed_tag());
+    if (is_empty_or_blocked_tag(last)) {
+      CAF_ASSERT(tail_ == nullptr);
+      return;
+    }
+    node_pointer ptr = tail_ != nullptr ? tail_ : await_first();
+    tail_ = nullptr;
+    while (ptr != last) {
+      auto next = await_next(ptr);
+      f(promote(ptr));
+      ptr = next;
+    }
+    f(last);
+  }
+
+  mpsc_inbox() noexcept : tail_(nullptr) {
+    head_ = empty_tag();
+    first_ = nullptr;
+  }
+
+  ~mpsc_inbox() noexcept {
+    if (!closed())
+      close();
+  }
+
+  // -- synchronized access ---------------------------------------------------
+
+  template <class Mutex, class CondVar>
+  bool synchronized_push_back(Mutex& mtx, CondVar& cv, pointer ptr) {
+    switch (push_back(ptr)) {
+      default:
+        // enqueued message to a running actor's mailbox
+        return true;
+      case inbox_result::unblocked_reader: {
+        std::unique_lock<Mutex> guard(mtx);
+        cv.notify_one();
+        return true;
+      }
+      case inbox_result::queue_closed:
+        // actor no longer alive
+        return false;
+    }
+  }
+
+  template <class Mutex, class CondVar>
+  bool synchronized_push_back(Mutex& mtx, CondVar& cv, unique_pointer ptr) {
+    return synchronized_push_back(mtx, cv, ptr.release());
+  }
+
+  template <class Mutex, class CondVar, class... Ts>
+  bool synchronized_emplace_back(Mutex& mtx, CondVar& cv, Ts&&... xs) {
+    return synchronized_push_back(mtx, cv,
+                                  new value_type(std::forward<Ts>(xs)...));
+  }
+
+  template <class Mutex, class CondVar>
+  void synchronized_await(Mutex& mtx, CondVar& cv) {
+    CAF_ASSERT(!closed());
+    if (try_block()) {
+      std::unique_lock<Mutex> guard(mtx);
+      while (blocked())
+        cv.wait(guard);
+    }
+  }
+
+  template <class Mutex, class CondVar, class TimePoint>
+  bool synchronized_await(Mutex& mtx, CondVar& cv, const TimePoint& timeout) {
+    CAF_ASSERT(!closed());
+    if (try_block()) {
+      std::unique_lock<Mutex> guard(mtx);
+      while (blocked()) {
+        if (cv.wait_until(guard, timeout) == std::cv_status::timeout) {
+          // if we're unable to set the queue from blocked to empty,
+          // than there's a new element in the list
+          return !try_unblock();
+        }
+      }
+    }
+    return true;
+  }
+
+private:
+  // -- tags -------------------------------------------------------------------
+
+  static constexpr pointer empty_tag() {
+    // We are *never* going to dereference the returned pointer. It is only
+    // used as indicator whether this queue is empty or not.
+    return static_cast<pointer>(nullptr);
+  }
+
+  pointer closed_tag() const noexcept {
+    // We are *never* going to dereference the returned pointer. It is only
+    // used as indicator whether this queue is closed or not.
+    return reinterpret_cast<pointer>(reinterpret_cast<intptr_t>(this) + 1);
+  }
+
+  pointer reader_blocked_tag() const noexcept {
+    // We are *never* going to dereference the returned pointer. It is only
+    // used as indicator whether the owner of the queue is currently waiting for
+    // new messages.
+    return reinterpret_cast<pointer>(const_cast<mpsc_inbox*>(this));
+  }
+
+  bool is_empty_or_blocked_tag(pointer x) const noexcept {
+    return x == empty_tag() || x == reader_blocked_tag();
+  }
+
+  // -- reader utility ---------------------------------------------------------
+
+  /// Grants atomic access to the `next` pointer of a node, since writers link
+  /// the previous head while the reader may poll it.
+  static std::atomic<node_pointer>& next_of(node_pointer ptr) noexcept {
+    static_assert(sizeof(std::atomic<node_pointer>) == sizeof(node_pointer));
+    static_assert(std::atomic<node_pointer>::is_always_lock_free);
+    return *reinterpret_cast<std::atomic<node_pointer>*>(&ptr->next);
+  }
+
+  /// Returns the first element after a writer has replaced an empty or blocked
+  /// tag. The writer stores the element right after replacing the tag, so we
+  /// only spin for a very short time.
+  node_pointer await_first() noexcept {
+    for (;;) {
+      if (auto ptr = first_.exchange(nullptr, std::memory_order_acquire))
+        return ptr;
+      std::this_thread::yield();
+    }
+  }
+
+  /// Returns the successor of `ptr` once its writer has linked it.
+  static node_pointer await_next(node_pointer ptr) noexcept {
+    for (;;) {
+      if (auto next = next_of(ptr).load(std::memory_order_acquire))
+        return next;
+      std::this_thread::yield();
+    }
+  }
+
+  /// Returns the successor of `ptr` or `nullptr` after resetting the queue to
+  /// empty if `ptr` was the last element.
+  node_pointer successor(node_pointer ptr) noexcept {
+    if (auto next = next_of(ptr).load(std::memory_order_acquire))
+      return next;
+    pointer e = promote(ptr);
+    if (head_.compare_exchange_strong(e, empty_tag()))
+      return nullptr;
+    // A writer has replaced `ptr` as head but did not link it yet.
+    return await_next(ptr);
+  }
+
+  // -- member variables ------------------------------------------------------
+
+  /// Points to the most recent element or stores a tag.
+  std::atomic<pointer> head_;
+
+  /// Hands the first element over to the reader after an empty or blocked
+  /// queue received a new element.
+  std::atomic<node_pointer> first_;
+
+  /// Points to the oldest element. Only accessed by the reader.
+  node_pointer tail_;
+};
+
+} // namespace caf::intrusive
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -25,6 +26,7 @@
 #include "caf/detail/typed_actor_util.hpp"
 #include "caf/detail/unique_function.hpp"
 #include "caf/error.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
 #include "caf/message_handler.hpp"
@@ -61,6 +63,12 @@ public:
 
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge* mailbox_size = nullptr;
+
+    /// Counts how many skipped messages are currently waiting in the stash.
+    telemetry::int_gauge* stash_size = nullptr;
+
+    /// Counts how often the actor retried skipped messages.
+    telemetry::int_counter* stash_retries = nullptr;
   };
 
   /// Optional metrics for inbound stream traffic collected by individual actors
@@ -387,6 +395,25 @@ public:
     return fail_state_;
   }
 
+  // -- bounded mailboxes ------------------------------------------------------
+
+  /// Returns the maximum number of ordinary messages in the mailbox or 0 if
+  /// the mailbox is unbounded.
+  size_t mailbox_capacity() const noexcept {
+    return mailbox_capacity_;
+  }
+
+  /// Returns how the actor handles messages that exceed its mailbox capacity.
+  mailbox_overflow_policy overflow_policy() const noexcept {
+    return overflow_policy_;
+  }
+
+  /// Returns the number of messages that currently count against the mailbox
+  /// capacity.
+  size_t bounded_mailbox_size() const noexcept {
+    return bounded_messages_.load(std::memory_order_relaxed);
+  }
+
   // -- here be dragons: end of public interface -------------------------------
 
   /// @cond PRIVATE
@@ -440,6 +467,31 @@ public:
   /// @endcond
 
 protected:
+  // -- bounded mailboxes ------------------------------------------------------
+
+  /// Returns whether `x` counts against the capacity of the mailbox. Responses,
+  /// high-priority messages, stream traffic and system messages such as
+  /// `exit_msg` or `down_msg` always bypass the limit.
+  bool is_bounded(const mailbox_element& x) const noexcept {
+    return mailbox_capacity_ > 0 && counts_against_capacity(x);
+  }
+
+  /// Tries to make room for `x` in the mailbox and applies the overflow policy
+  /// if the mailbox is full. Each successful call requires a call to
+  /// `release_mailbox_slot` after the actor removed `x` from its mailbox.
+  /// @returns `true` if the caller may enqueue `x`, `false` if the actor
+  ///          disposes `x`.
+  /// @pre `is_bounded(x)`
+  bool reserve_mailbox_slot(const mailbox_element& x, execution_unit* ctx);
+
+  /// Frees the slot of a message that left the mailbox.
+  void release_mailbox_slot();
+
+  /// Frees the slot of the oldest message in the mailbox if the policy is
+  /// `drop_oldest` and the mailbox exceeds its capacity.
+  /// @returns `true` if the actor must discard its oldest message.
+  bool discard_oldest();
+
   // -- member variables -------------------------------------------------------
 
   // identifies the execution unit this actor is currently executed by
@@ -455,6 +507,28 @@ protected:
   detail::unique_function<behavior(local_actor*)> initial_behavior_fac_;
 
   metrics_t metrics_;
+
+private:
+  struct blocked_senders;
+
+  static bool counts_against_capacity(const mailbox_element& x) noexcept;
+
+  void count_overflow();
+
+  // Maximum number of bounded messages in the mailbox or 0 for no limit.
+  size_t mailbox_capacity_;
+
+  // Selects how to handle messages that exceed the capacity.
+  mailbox_overflow_policy overflow_policy_;
+
+  // Number of bounded messages in the mailbox.
+  std::atomic<size_t> bounded_messages_;
+
+  // Counts messages that exceeded the capacity.
+  telemetry::int_counter* mailbox_overflows_;
+
+  // Allows senders to wait for room in the mailbox with the policy `block`.
+  std::unique_ptr<blocked_senders> blocked_senders_;
 };
 
 } // namespace caf
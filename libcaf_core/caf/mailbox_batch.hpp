@@ -0,0 +1,122 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstddef>
+
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+
+/// An owning, singly linked sequence of mailbox elements for a single
+/// receiver. Actors enqueue a batch to their mailbox with a single atomic
+/// operation (see `abstract_actor::enqueue_batch`).
+class mailbox_batch {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  mailbox_batch() noexcept : head_(nullptr), tail_(nullptr), size_(0) {
+    // nop
+  }
+
+  mailbox_batch(mailbox_batch&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), size_(other.size_) {
+    other.head_ = nullptr;
+    other.tail_ = nullptr;
+    other.size_ = 0;
+  }
+
+  mailbox_batch& operator=(mailbox_batch&& other) noexcept {
+    using std::swap;
+    swap(head_, other.head_);
+    swap(tail_, other.tail_);
+    swap(size_, other.size_);
+    return *this;
+  }
+
+  mailbox_batch(const mailbox_batch&) = delete;
+
+  mailbox_batch& operator=(const mailbox_batch&) = delete;
+
+  ~mailbox_batch() {
+    clear();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether this batch contains no elements.
+  bool empty() const noexcept {
+    return head_ == nullptr;
+  }
+
+  /// Returns the number of elements in this batch.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the oldest element.
+  /// @pre `!empty()`
+  mailbox_element* front() const noexcept {
+    return head_;
+  }
+
+  /// Returns the most recent element.
+  /// @pre `!empty()`
+  mailbox_element* back() const noexcept {
+    return tail_;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Appends `ptr` to the batch.
+  /// @pre `ptr != nullptr`
+  void push_back(mailbox_element_ptr ptr) noexcept {
+    CAF_ASSERT(ptr != nullptr);
+    auto x = ptr.release();
+    x->next = nullptr;
+    if (tail_ == nullptr)
+      head_ = x;
+    else
+      tail_->next = x;
+    tail_ = x;
+    ++size_;
+  }
+
+  /// Removes the oldest element from the batch.
+  /// @returns the oldest element or `nullptr` if the batch is empty.
+  mailbox_element_ptr pop_front() noexcept {
+    if (head_ == nullptr)
+      return nullptr;
+    auto x = head_;
+    head_ = static_cast<mailbox_element*>(x->next);
+    if (head_ == nullptr)
+      tail_ = nullptr;
+    x->next = nullptr;
+    --size_;
+    return mailbox_element_ptr{x};
+  }
+
+  /// Releases ownership of all elements. The elements remain linked via their
+  /// `next` pointer, i.e., `front()` points to the head of the chain and
+  /// `back()->next` is `nullptr`.
+  void release() noexcept {
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+  }
+
+  /// Deletes all elements.
+  void clear() noexcept {
+    while (pop_front() != nullptr)
+      ; // nop
+  }
+
+private:
+  mailbox_element* head_;
+  mailbox_element* tail_;
+  size_t size_;
+};
+
+} // namespace caf
@@ -7,12 +7,20 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
 
 #include "caf/actor_control_block.hpp"
+#include "caf/byte.hpp"
+#include "caf/config.hpp"
 #include "caf/detail/core_export.hpp"
+#include "caf/detail/message_data.hpp"
+#include "caf/detail/padded_size.hpp"
+#include "caf/detail/slab_allocator.hpp"
 #include "caf/intrusive/singly_linked.hpp"
 #include "caf/message.hpp"
 #include "caf/message_id.hpp"
+#include "caf/raise_error.hpp"
 #include "caf/tracing_data.hpp"
 
 namespace caf {
@@ -22,6 +30,25 @@ class CAF_CORE_EXPORT mailbox_element
 public:
   using forwarding_stack = std::vector<strong_actor_ptr>;
 
+  /// Maximum number of bytes for storing the payload, including the header of
+  /// the message data, in the mailbox element itself. Configured at build
+  /// time via `CAF_INLINE_PAYLOAD_SIZE`.
+  static constexpr size_t inline_payload_size = CAF_INLINE_PAYLOAD_SIZE;
+
+  /// Checks whether a mailbox element stores a message with elements of types
+  /// `Ts` inline. This optimization only applies to small, trivially copyable
+  /// types, because copying or moving the payload of an element copies inline
+  /// data to the heap.
+  template <class... Ts>
+  static constexpr bool stores_inline() {
+    if constexpr (inline_payload_size == 0 || sizeof...(Ts) == 0)
+      return false;
+    else
+      return (std::is_trivially_copyable<Ts>::value && ...)
+             && sizeof(detail::message_data) + (detail::padded_size_v<Ts> + ...)
+                  <= inline_payload_size;
+  }
+
   /// Source of this message and receiver of the final response.
   strong_actor_ptr sender;
 
@@ -50,6 +77,11 @@ public:
     enqueue_time = std::chrono::steady_clock::now();
   }
 
+  /// Checks whether `set_enqueue_time` has been called on this element.
+  bool has_enqueue_time() const noexcept {
+    return enqueue_time != std::chrono::steady_clock::time_point{};
+  }
+
   /// Returns the time between enqueueing the message and `t`.
   double seconds_until(std::chrono::steady_clock::time_point t) const {
     namespace ch = std::chrono;
@@ -68,6 +100,23 @@ public:
   mailbox_element(strong_actor_ptr sender, message_id mid,
                   forwarding_stack stages, message payload);
 
+  /// Constructs the payload from `xs...` in the memory of this element.
+  /// @pre `payload.empty()`
+  /// @pre `stores_inline<detail::strip_and_convert_t<Ts>...>()`
+  template <class... Ts>
+  void emplace_inline_payload(Ts&&... xs) {
+#if CAF_INLINE_PAYLOAD_SIZE > 0
+    using detail::strip_and_convert_t;
+    static_assert(stores_inline<strip_and_convert_t<Ts>...>());
+    auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
+    auto raw_ptr = new (inline_payload_) detail::message_data(types, true);
+    payload.reset(raw_ptr, false);
+    raw_ptr->init(std::forward<Ts>(xs)...);
+#else
+    static_assert(sizeof...(Ts) == 0, "inline payloads are disabled");
+#endif
+  }
+
   bool is_high_priority() const {
     return mid.category() == message_id::urgent_message_category;
   }
@@ -77,6 +126,20 @@ public:
   mailbox_element& operator=(mailbox_element&&) = delete;
   mailbox_element& operator=(const mailbox_element&) = delete;
 
+  // -- memory management ------------------------------------------------------
+
+#ifdef CAF_ENABLE_SLAB_ALLOCATOR
+  static void* operator new(size_t size) {
+    if (auto ptr = detail::slab_allocator::allocate(size))
+      return ptr;
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  }
+
+  static void operator delete(void* ptr, size_t size) noexcept {
+    detail::slab_allocator::deallocate(ptr, size);
+  }
+#endif // CAF_ENABLE_SLAB_ALLOCATOR
+
   // -- backward compatibility -------------------------------------------------
 
   message& content() noexcept {
@@ -86,6 +149,11 @@ public:
   const message& content() const noexcept {
     return payload;
   }
+
+private:
+#if CAF_INLINE_PAYLOAD_SIZE > 0
+  alignas(std::max_align_t) byte inline_payload_[CAF_INLINE_PAYLOAD_SIZE];
+#endif
 };
 
 /// @relates mailbox_element
@@ -115,9 +183,18 @@ std::enable_if_t<!std::is_same<typename std::decay<T>::type, message>::value
 make_mailbox_element(strong_actor_ptr sender, message_id id,
                      mailbox_element::forwarding_stack stages, T&& x,
                      Ts&&... xs) {
-  return make_mailbox_element(std::move(sender), id, std::move(stages),
-                              make_message(std::forward<T>(x),
-                                           std::forward<Ts>(xs)...));
+  using detail::strip_and_convert_t;
+  if constexpr (mailbox_element::stores_inline<
+                  strip_and_convert_t<T>, strip_and_convert_t<Ts>...>()) {
+    auto ptr = std::make_unique<mailbox_element>(std::move(sender), id,
+                                                 std::move(stages), message{});
+    ptr->emplace_inline_payload(std::forward<T>(x), std::forward<Ts>(xs)...);
+    return ptr;
+  } else {
+    return make_mailbox_element(std::move(sender), id, std::move(stages),
+                                make_message(std::forward<T>(x),
+                                             std::forward<Ts>(xs)...));
+  }
 }
 
 } // namespace caf
@@ -0,0 +1,49 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// Selects how a bounded mailbox handles messages that exceed its capacity.
+enum class mailbox_overflow_policy : uint8_t {
+  /// Silently discards the new message.
+  drop_newest,
+  /// Accepts the new message and discards the oldest message in the mailbox.
+  drop_oldest,
+  /// Discards the new message and responds to requests with
+  /// `sec::mailbox_full`.
+  reject,
+  /// Blocks the sender until the mailbox has room for the new message. Only
+  /// blocking actors and non-actor threads may block. The mailbox rejects
+  /// messages from all other senders.
+  block,
+};
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT std::string to_string(mailbox_overflow_policy);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool from_string(string_view, mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool
+from_integer(std::underlying_type_t<mailbox_overflow_policy>,
+             mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+template <class Inspector>
+bool inspect(Inspector& f, mailbox_overflow_policy& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
@@ -35,13 +35,31 @@ public:
 
   message() noexcept = default;
 
-  message(message&&) noexcept = default;
+  // Note: messages must never share embedded data (see
+  // `mailbox_element::stores_inline`), because the embedded data may not
+  // outlive its storage. Hence, copying or moving such a message copies the
+  // content to the heap.
+
+  message(message&& other) noexcept : data_(std::move(other.data_)) {
+    if (data_ && data_->embedded())
+      data_.reset(data_->copy(), false);
+  }
 
-  message(const message&) noexcept = default;
+  message(const message& other) noexcept : data_(detach(other.data_)) {
+    // nop
+  }
 
-  message& operator=(message&&) noexcept = default;
+  message& operator=(message&& other) noexcept {
+    data_ = std::move(other.data_);
+    if (data_ && data_->embedded())
+      data_.reset(data_->copy(), false);
+    return *this;
+  }
 
-  message& operator=(const message&) noexcept = default;
+  message& operator=(const message& other) noexcept {
+    data_ = detach(other.data_);
+    return *this;
+  }
 
   // -- concatenation ----------------------------------------------------------
 
@@ -164,7 +182,14 @@ public:
   // -- modifiers --------------------------------------------------------------
 
   void swap(message& other) noexcept {
-    data_.swap(other.data_);
+    if ((data_ && data_->embedded())
+        || (other.data_ && other.data_->embedded())) {
+      message tmp{std::move(other)};
+      other = std::move(*this);
+      *this = std::move(tmp);
+    } else {
+      data_.swap(other.data_);
+    }
   }
 
   void reset(detail::message_data* new_ptr = nullptr,
@@ -179,6 +204,12 @@ public:
   }
 
 private:
+  static data_ptr detach(const data_ptr& ptr) {
+    if (ptr && ptr->embedded())
+      return data_ptr{ptr->copy(), false};
+    return ptr;
+  }
+
   template <size_t Pos, class T>
   bool matches_at(const T& value) const {
     if constexpr (std::is_same<T, decltype(std::ignore)>::value)
@@ -209,9 +240,9 @@ message make_message(Ts&&... xs) {
   static_assert((!std::is_pointer<strip_and_convert_t<Ts>>::value && ...));
   static_assert((is_complete<type_id<strip_and_convert_t<Ts>>> && ...));
   static constexpr size_t data_size
-    = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
+    = (padded_size_v<strip_and_convert_t<Ts>> + ...);
   auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
-  auto vptr = malloc(data_size);
+  auto vptr = message_data::allocate(data_size);
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   auto raw_ptr = new (vptr) message_data(types);
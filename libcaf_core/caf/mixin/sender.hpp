@@ -5,6 +5,7 @@
 #pragma once
 
 #include <chrono>
+#include <iterator>
 #include <tuple>
 
 #include "caf/actor.hpp"
@@ -15,6 +16,7 @@
 #include "caf/detail/profiled_send.hpp"
 #include "caf/detail/type_traits.hpp"
 #include "caf/fwd.hpp"
+#include "caf/mailbox_batch.hpp"
 #include "caf/message.hpp"
 #include "caf/message_priority.hpp"
 #include "caf/no_stages.hpp"
@@ -208,6 +210,97 @@ public:
                           make_message_id(P), std::forward<Ts>(xs)...);
   }
 
+  // -- batch sending ----------------------------------------------------------
+
+  /// Collects messages to a single receiver and enqueues all of them at once.
+  /// Compared to calling `send` for each message, the receiver updates its
+  /// mailbox with a single atomic operation and schedules itself at most once.
+  /// @note Destroying a batch sender without calling `send` discards all
+  ///       pending messages.
+  template <class Self, class Dest, message_priority P>
+  class batch_sender {
+  public:
+    batch_sender(Self* self, Dest dest) : self_(self), dest_(std::move(dest)) {
+      // nop
+    }
+
+    batch_sender(batch_sender&&) = default;
+
+    batch_sender& operator=(batch_sender&&) = default;
+
+    /// Adds `{xs...}` as a new message to the batch.
+    template <class... Ts>
+    batch_sender& add(Ts&&... xs) {
+      static_assert(sizeof...(Ts) > 0, "no message to send");
+      static_assert((detail::sendable<Ts> && ...),
+                    "at least one type has no ID, "
+                    "did you forgot to announce it via CAF_ADD_TYPE_ID?");
+      detail::type_list<detail::strip_and_convert_t<Ts>...> args_token;
+      type_check(dest_, args_token);
+      auto element = make_mailbox_element(self_->ctrl(), make_message_id(P),
+                                          no_stages, std::forward<Ts>(xs)...);
+      CAF_BEFORE_SENDING(self_, *element);
+      elements_.push_back(std::move(element));
+      return *this;
+    }
+
+    /// Returns the number of pending messages.
+    size_t size() const noexcept {
+      return elements_.size();
+    }
+
+    /// Enqueues all pending messages to the receiver.
+    void send() {
+      if (elements_.empty())
+        return;
+      if (dest_) {
+        auto ptr = actor_cast<abstract_actor*>(dest_);
+        ptr->enqueue_batch(std::move(elements_), self_->context());
+      } else {
+        auto n = static_cast<int64_t>(elements_.size());
+        self_->home_system().base_metrics().rejected_messages->inc(n);
+        elements_.clear();
+      }
+    }
+
+  private:
+    Self* self_;
+    Dest dest_;
+    mailbox_batch elements_;
+  };
+
+  /// Returns a builder for sending multiple messages to `dest` at once, e.g.,
+  /// `self->make_batch(dest).add(1).add(2).send()`.
+  template <message_priority P = message_priority::normal, class Dest = actor>
+  auto make_batch(const Dest& dest) {
+    static_assert(!std::is_same<Dest, group>::value,
+                  "cannot send a batch of messages to a group");
+    auto self = dptr();
+    using self_type = std::remove_pointer_t<decltype(self)>;
+    return batch_sender<self_type, Dest, P>{self, dest};
+  }
+
+  /// Sends each element in `[first, last)` as a separate message to `dest`,
+  /// enqueueing all messages at once (see `make_batch`).
+  template <message_priority P = message_priority::normal, class Dest = actor,
+            class InputIterator>
+  void send_batch(const Dest& dest, InputIterator first, InputIterator last) {
+    auto batch = make_batch<P>(dest);
+    for (; first != last; ++first)
+      batch.add(*first);
+    batch.send();
+  }
+
+  /// Sends each element in `xs` as a separate message to `dest`, enqueueing
+  /// all messages at once (see `make_batch`).
+  template <message_priority P = message_priority::normal, class Dest = actor,
+            class Range>
+  void send_batch(const Dest& dest, const Range& xs) {
+    using std::begin;
+    using std::end;
+    send_batch<P>(dest, begin(xs), end(xs));
+  }
+
 private:
   template <class Dest, class ArgTypes>
   static void type_check(const Dest&, ArgTypes) {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/detail/conflation_rules.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/mailbox_element.hpp"
@@ -17,7 +18,8 @@
 namespace caf::policy {
 
 /// Configures a cached WDRR fixed multiplexed queue for dispatching to four
-/// nested queue (one for each message category type).
+/// nested queue (one for each message category type). Optionally dispatches
+/// asynchronous messages that match a conflation rule to a fifth queue.
 class CAF_CORE_EXPORT categorized {
 public:
   // -- member types -----------------------------------------------------------
@@ -65,9 +67,23 @@ public:
     return x;
   }
 
-  static size_t id_of(const mailbox_element& x) noexcept {
-    return static_cast<size_t>(x.mid.category());
+  size_t id_of(const mailbox_element& x) const noexcept {
+    auto result = static_cast<size_t>(x.mid.category());
+    if (conflation != nullptr && result == message_id::normal_message_category
+        && x.mid.is_async() && conflation->find(x.payload) != nullptr)
+      return conflating_queue_index;
+    return result;
   }
+
+  // -- constants --------------------------------------------------------------
+
+  /// Position of the queue for conflated messages.
+  static constexpr size_t conflating_queue_index = 4;
+
+  // -- member variables -------------------------------------------------------
+
+  /// Selects messages for the queue at `conflating_queue_index` if not null.
+  const detail::conflation_rules* conflation = nullptr;
 };
 
 } // namespace caf::policy
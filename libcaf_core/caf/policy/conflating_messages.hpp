@@ -0,0 +1,80 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <utility>
+
+#include "caf/detail/conflation_rules.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/unit.hpp"
+
+namespace caf::policy {
+
+/// Configures a conflating DRR queue for holding asynchronous messages that
+/// match one of the conflation rules of an actor.
+class CAF_CORE_EXPORT conflating_messages {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using mapped_type = mailbox_element;
+
+  using task_size_type = size_t;
+
+  using deficit_type = size_t;
+
+  using unique_pointer = mailbox_element_ptr;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  conflating_messages() = default;
+
+  conflating_messages(const conflating_messages&) = default;
+
+  conflating_messages& operator=(const conflating_messages&) = default;
+
+  constexpr conflating_messages(unit_t) {
+    // nop
+  }
+
+  // -- interface required by drr_queue ----------------------------------------
+
+  static task_size_type task_size(const mailbox_element&) noexcept {
+    return 1;
+  }
+
+  // -- interface required by drr_conflating_queue -----------------------------
+
+  /// Returns the hash value for the key of `x`.
+  /// @pre `rules != nullptr && rules->find(x.payload) != nullptr`
+  size_t hash_key(const mailbox_element& x) const {
+    return rules->find(x.payload)->hash(x.payload);
+  }
+
+  /// Checks whether `x` and `y` have the same key.
+  bool equal_keys(const mailbox_element& x, const mailbox_element& y) const {
+    if (x.payload.type_at(0) != y.payload.type_at(0))
+      return false;
+    return rules->find(x.payload)->equal(x.payload, y.payload);
+  }
+
+  /// Moves the content of `x` to `pending` and vice versa, i.e., `pending`
+  /// keeps its position in the queue but now holds the new message.
+  static void supersede(mailbox_element& pending, mailbox_element& x) noexcept {
+    using std::swap;
+    swap(pending.sender, x.sender);
+    swap(pending.mid, x.mid);
+    swap(pending.stages, x.stages);
+    pending.payload.swap(x.payload);
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// Points to the conflation rules of the owning actor.
+  const detail::conflation_rules* rules = nullptr;
+};
+
+} // namespace caf::policy
@@ -0,0 +1,200 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "caf/detail/core_export.hpp"
+#include "caf/logger.hpp"
+#include "caf/policy/work_stealing.hpp"
+#include "caf/telemetry/gauge.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::policy {
+
+/// Implements scheduling of actors via work stealing with a varying number of
+/// active workers. Starts with `caf.elastic-stealing.min-threads` active
+/// workers, activates additional workers (up to `caf.scheduler.max-threads`)
+/// while workers have a backlog of jobs and deactivates workers again after
+/// they remain idle for `caf.elastic-stealing.idle-timeout`.
+/// @extends scheduler_policy
+class CAF_CORE_EXPORT elastic_work_stealing : public work_stealing {
+public:
+  ~elastic_work_stealing() override;
+
+  using clock_type = std::chrono::steady_clock;
+
+  // Keeps track of active workers. Shared by all workers.
+  struct elastic_state {
+    explicit elastic_state(scheduler::abstract_coordinator* p);
+
+    // Workers with an ID below this value are active. Inactive workers receive
+    // no jobs from the coordinator and block until activated again.
+    std::atomic<size_t> active_workers;
+
+    // Time of the last activation in nanoseconds since the clock's epoch.
+    std::atomic<int64_t> last_activation;
+
+    // Lower bound for `active_workers`.
+    size_t min_workers;
+
+    // Upper bound for `active_workers`.
+    size_t max_workers;
+
+    // Number of jobs in the queue of a worker that signals a backlog.
+    size_t grow_threshold;
+
+    // Minimum time between activating two workers.
+    timespan grow_interval;
+
+    // Time after which idle workers become inactive.
+    timespan idle_timeout;
+
+    // Reports the current value of `active_workers`.
+    telemetry::int_gauge* active_workers_gauge;
+  };
+
+  // Holds job queue of a worker and the shared elastic state.
+  struct worker_data : worker_state {
+    explicit worker_data(scheduler::abstract_coordinator* p);
+
+    worker_data(const worker_data& other);
+
+    // This queue is exposed to other workers that may attempt to steal jobs
+    // from it and the central scheduling unit can push new jobs to the queue.
+    queue_type queue;
+
+    // Counts active workers and stores the configuration.
+    std::shared_ptr<elastic_state> elastic;
+  };
+
+  // Picks a victim among the active workers.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
+    auto& data = d(self);
+    auto p = self->parent();
+    auto n = data.elastic->active_workers.load();
+    if (n < 2 || self->id() >= n)
+      return p->steal_from_other_domains();
+    // Roll the dice to pick an active victim other than ourselves.
+    std::uniform_int_distribution<size_t> uniform{0, n - 2};
+    auto victim = uniform(data.rengine);
+    if (victim == self->id())
+      victim = n - 1;
+    if (auto job = steal_from(self, p->worker_by_id(victim)))
+      return job;
+    return p->steal_from_other_domains();
+  }
+
+  // Takes the oldest job of one of our active workers.
+  template <class Coordinator>
+  resumable* steal_job(Coordinator* self) {
+    auto& st = *d(self->worker_by_id(0)).elastic;
+    auto n = st.active_workers.load();
+    auto w = self->worker_by_id(d(self).next_worker++ % n);
+    return d(w).queue.take_tail();
+  }
+
+  // Dispatches jobs from non-actor code round-robin to active workers only.
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable* job) {
+    auto& st = *d(self->worker_by_id(0)).elastic;
+    auto n = st.active_workers.load();
+    auto w = self->worker_by_id(d(self).next_worker++ % n);
+    w->external_enqueue(job);
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    auto& data = d(self);
+    auto& st = *data.elastic;
+    for (;;) {
+      if (self->id() < st.active_workers.load()) {
+        auto steal = [this](Worker* thief) { return try_steal(thief); };
+        auto keep_waiting = [&](timespan idle) {
+          return idle < st.idle_timeout || !deactivate(self);
+        };
+        if (auto job = work_stealing::dequeue(self, steal, keep_waiting)) {
+          maybe_activate(self);
+          return job;
+        }
+      } else if (auto job = wait_for_activation(self)) {
+        return job;
+      }
+    }
+  }
+
+private:
+  // Activates another worker if `self` has a backlog of jobs.
+  template <class Worker>
+  void maybe_activate(Worker* self) {
+    auto& data = d(self);
+    auto& st = *data.elastic;
+    if (data.queue.size() < st.grow_threshold)
+      return;
+    auto n = st.active_workers.load();
+    if (n >= st.max_workers)
+      return;
+    // Only grow once per interval to observe the effect of the last step.
+    auto now = clock_type::now().time_since_epoch().count();
+    auto last = st.last_activation.load();
+    if (now - last < st.grow_interval.count()
+        || !st.last_activation.compare_exchange_strong(last, now))
+      return;
+    if (!st.active_workers.compare_exchange_strong(n, n + 1))
+      return;
+    CAF_LOG_DEBUG("activate worker" << n);
+    st.active_workers_gauge->inc();
+    d(self->parent()->worker_by_id(n)).parking.notify_one();
+  }
+
+  // Deactivates `self` if it is the active worker with the highest ID and
+  // moves its remaining jobs to other workers. Returns whether `self` became
+  // inactive.
+  template <class Worker>
+  bool deactivate(Worker* self) {
+    auto& data = d(self);
+    auto& st = *data.elastic;
+    auto n = self->id() + 1;
+    if (n <= st.min_workers
+        || !st.active_workers.compare_exchange_strong(n, self->id()))
+      return false;
+    CAF_LOG_DEBUG("deactivate worker" << self->id());
+    st.active_workers_gauge->dec();
+    // Jobs may have arrived since our last dequeue attempt.
+    auto p = self->parent();
+    size_t i = 0;
+    while (auto job = take_head(data))
+      p->worker_by_id(i++ % self->id())->external_enqueue(job);
+    return true;
+  }
+
+  // Blocks an inactive worker until it becomes active again. Still runs jobs
+  // that other workers or the coordinator enqueue directly to this worker.
+  template <class Worker>
+  resumable* wait_for_activation(Worker* self) {
+    auto& data = d(self);
+    auto& st = *data.elastic;
+    for (;;) {
+      auto key = data.parking.prepare_wait();
+      if (auto job = take_head(data)) {
+        data.parking.cancel_wait();
+        return job;
+      }
+      if (self->id() < st.active_workers.load()) {
+        data.parking.cancel_wait();
+        return nullptr;
+      }
+      data.parking.wait(key);
+    }
+  }
+};
+
+} // namespace caf::policy
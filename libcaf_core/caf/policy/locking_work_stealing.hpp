@@ -0,0 +1,39 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/policy/work_stealing.hpp"
+
+namespace caf::policy {
+
+/// Implements scheduling of actors via work stealing, using a spinlock-based
+/// `double_ended_queue` for the job queue of each worker. This was the default
+/// queue of `work_stealing` before switching to a lock-free Chase-Lev deque
+/// and remains available as a fallback.
+/// @extends scheduler_policy
+class CAF_CORE_EXPORT locking_work_stealing : public work_stealing {
+public:
+  ~locking_work_stealing() override;
+
+  // A thread-safe queue implementation.
+  using queue_type = detail::double_ended_queue<resumable>;
+
+  // Holds job queue of a worker and a random number generator.
+  struct worker_data : worker_state {
+    using worker_state::worker_state;
+
+    worker_data(const worker_data& other) : worker_state(other) {
+      // nop
+    }
+
+    // This queue is exposed to other workers that may attempt to steal jobs
+    // from it and the central scheduling unit can push new jobs to the queue.
+    queue_type queue;
+  };
+};
+
+} // namespace caf::policy
@@ -7,6 +7,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/mailbox_element.hpp"
+#include "caf/type_id_list.hpp"
 #include "caf/unit.hpp"
 
 namespace caf::policy {
@@ -25,6 +26,8 @@ public:
 
   using unique_pointer = mailbox_element_ptr;
 
+  using stash_key_type = type_id_list;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   normal_messages() = default;
@@ -42,6 +45,24 @@ public:
   static task_size_type task_size(const mailbox_element&) noexcept {
     return 1;
   }
+
+  // -- interface required by drr_stashing_queue -------------------------------
+
+  /// Returns the types of `x` if `self` skipped `x` only because its current
+  /// behavior has no handler for these types, otherwise a null list.
+  type_id_list stash_key(const mailbox_element& x) const noexcept;
+
+  /// Returns a value that changes whenever `self` changes its behavior or its
+  /// default handler.
+  size_t stash_epoch() const noexcept;
+
+  /// Checks whether `self` may now accept messages of given types.
+  bool retry(type_id_list types) const noexcept;
+
+  // -- member variables -------------------------------------------------------
+
+  /// Points to the owning actor if it indexes skipped messages.
+  const scheduled_actor* self = nullptr;
 };
 
 } // namespace caf::policy
@@ -0,0 +1,151 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "caf/actor_config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/numa_topology.hpp"
+#include "caf/detail/set_thread_affinity.hpp"
+#include "caf/logger.hpp"
+#include "caf/policy/work_stealing.hpp"
+
+namespace caf::policy {
+
+/// Implements scheduling of actors via work stealing on NUMA machines. Pins
+/// each worker to a CPU, prefers stealing jobs from workers on the same NUMA
+/// node and moves actors with a preferred NUMA node to a worker on that node.
+/// @extends scheduler_policy
+class CAF_CORE_EXPORT numa_work_stealing : public work_stealing {
+public:
+  ~numa_work_stealing() override;
+
+  // Assigns workers to CPUs and NUMA nodes. Shared by all workers.
+  struct layout_type {
+    explicit layout_type(scheduler::abstract_coordinator* p);
+
+    // Worker IDs, grouped by NUMA node.
+    std::vector<std::vector<size_t>> node_workers;
+
+    // NUMA node ID for each entry in `node_workers`.
+    std::vector<size_t> node_ids;
+
+    // Index into `node_workers` for each worker.
+    std::vector<size_t> worker_node;
+
+    // CPU for each worker or -1 if the worker runs unpinned.
+    std::vector<int> worker_cpu;
+
+    // Round-robin counters for each entry in `node_workers`.
+    std::unique_ptr<std::atomic<size_t>[]> next_worker;
+
+    // Every n-th steal attempt picks a victim on another NUMA node.
+    size_t inter_node_steal_interval;
+
+    // Returns the index into `node_workers` for the NUMA node `id` or
+    // `node_workers.size()` if no worker runs on that node.
+    size_t index_of(size_t id) const noexcept;
+  };
+
+  // Holds job queue of a worker and the shared NUMA layout.
+  struct worker_data : worker_state {
+    explicit worker_data(scheduler::abstract_coordinator* p);
+
+    worker_data(const worker_data& other);
+
+    // This queue is exposed to other workers that may attempt to steal jobs
+    // from it and the central scheduling unit can push new jobs to the queue.
+    queue_type queue;
+
+    // Maps workers to CPUs and NUMA nodes.
+    std::shared_ptr<const layout_type> layout;
+
+    // Counts steal attempts for deciding when to cross NUMA nodes.
+    size_t steal_rounds;
+  };
+
+  // Pins the worker thread to its CPU.
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    work_stealing::init_worker_thread(self);
+    auto cpu = d(self).layout->worker_cpu[self->id()];
+    if (cpu >= 0 && !detail::set_thread_affinity(cpu)) {
+      CAF_LOG_WARNING("unable to pin worker" << self->id() << "to CPU" << cpu);
+    }
+  }
+
+  // Prefers stealing from workers on the same NUMA node.
+  template <class Worker>
+  resumable* try_steal(Worker* self) {
+    auto& data = d(self);
+    auto& layout = *data.layout;
+    auto& peers = layout.node_workers[layout.worker_node[self->id()]];
+    if (peers.size() < 2
+        || ++data.steal_rounds % layout.inter_node_steal_interval == 0)
+      return work_stealing::try_steal(self);
+    // Roll the dice to pick a victim on our node other than ourselves.
+    std::uniform_int_distribution<size_t> uniform{0, peers.size() - 2};
+    auto victim = peers[uniform(data.rengine)];
+    if (victim == self->id())
+      victim = peers.back();
+    return steal_from(self, self->parent()->worker_by_id(victim));
+  }
+
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable* job) {
+    if (!relocate(self, job))
+      work_stealing::external_enqueue(self, job);
+  }
+
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable* job) {
+    if (!relocate(self, job))
+      work_stealing::internal_enqueue(self, job);
+  }
+
+  template <class Worker>
+  void resume_job_later(Worker* self, resumable* job) {
+    if (!relocate(self, job))
+      work_stealing::resume_job_later(self, job);
+  }
+
+  template <class Worker>
+  resumable* dequeue(Worker* self) {
+    return work_stealing::dequeue(self, [this](Worker* thief) {
+      return try_steal(thief);
+    });
+  }
+
+private:
+  // Returns the preferred NUMA node of `job` or `actor_config::any_numa_node`.
+  static size_t numa_node_of(resumable* job) noexcept;
+
+  // Moves `job` to a worker on its preferred NUMA node if `self` runs on a
+  // different node. Returns whether `job` was moved.
+  template <class Worker>
+  bool relocate(Worker* self, resumable* job) {
+    auto& layout = *d(self).layout;
+    if (layout.node_workers.size() < 2)
+      return false;
+    auto preferred = numa_node_of(job);
+    if (preferred == actor_config::any_numa_node)
+      return false;
+    auto index = layout.index_of(preferred);
+    if (index == layout.node_workers.size()
+        || index == layout.worker_node[self->id()])
+      return false;
+    auto& workers = layout.node_workers[index];
+    auto id = workers[layout.next_worker[index]++ % workers.size()];
+    self->parent()->worker_by_id(id)->external_enqueue(job);
+    return true;
+  }
+};
+
+} // namespace caf::policy
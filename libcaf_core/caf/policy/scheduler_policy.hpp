@@ -47,6 +47,10 @@ public:
   template <class Worker>
   resumable* dequeue(Worker* self);
 
+  /// Called by the thread of a worker before it starts dequeueing jobs.
+  template <class Worker>
+  void init_worker_thread(Worker* self);
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker* self);
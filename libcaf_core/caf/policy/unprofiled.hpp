@@ -18,6 +18,12 @@ class CAF_CORE_EXPORT unprofiled {
 public:
   virtual ~unprofiled();
 
+  /// Called by the thread of a worker before it starts dequeueing jobs.
+  template <class Worker>
+  void init_worker_thread(Worker*) {
+    // nop
+  }
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker*) {
@@ -44,6 +50,13 @@ public:
     // nop
   }
 
+  /// Takes a job from one of the workers for running it in another scheduler
+  /// domain. Returns `nullptr` if the policy does not support this.
+  template <class Coordinator>
+  resumable* steal_job(Coordinator*) {
+    return nullptr;
+  }
+
 protected:
   // Convenience function to access the data field.
   template <class WorkerOrCoordinator>
@@ -6,18 +6,21 @@
 
 #include <array>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
-#include <deque>
-#include <mutex>
 #include <random>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "caf/actor_system_config.hpp"
 #include "caf/detail/core_export.hpp"
-#include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/eventcount.hpp"
+#include "caf/detail/work_stealing_queue.hpp"
+#include "caf/fwd.hpp"
+#include "caf/message_priority.hpp"
 #include "caf/policy/unprofiled.hpp"
 #include "caf/resumable.hpp"
+#include "caf/telemetry/counter.hpp"
 #include "caf/timespan.hpp"
 
 namespace caf::policy {
@@ -28,8 +31,9 @@ class CAF_CORE_EXPORT work_stealing : public unprofiled {
 public:
   ~work_stealing() override;
 
-  // A thread-safe queue implementation.
-  using queue_type = detail::double_ended_queue<resumable>;
+  // A thread-safe queue implementation. Jobs of the owner live in a lock-free
+  // Chase-Lev deque, see `locking_work_stealing` for a spinlock-based fallback.
+  using queue_type = detail::work_stealing_queue<resumable>;
 
   // configuration for aggressive/moderate/relaxed poll strategies.
   struct poll_strategy {
@@ -39,13 +43,6 @@ public:
     timespan sleep_duration;
   };
 
-  // what is needed to implement the waiting strategy.
-  struct wait_strategy {
-    std::mutex lock;
-    std::condition_variable cv;
-    bool sleeping{false};
-  };
-
   // The coordinator has only a counter for round-robin enqueue to its workers.
   struct coordinator_data {
     explicit coordinator_data(scheduler::abstract_coordinator*)
@@ -56,35 +53,116 @@ public:
     std::atomic<size_t> next_worker;
   };
 
-  // Holds job job queue of a worker and a random number generator.
-  struct worker_data {
-    explicit worker_data(scheduler::abstract_coordinator* p);
-    worker_data(const worker_data& other);
+  // Holds the state of a worker that does not depend on the queue type.
+  struct worker_state {
+    explicit worker_state(scheduler::abstract_coordinator* p);
+    worker_state(const worker_state& other);
 
-    // This queue is exposed to other workers that may attempt to steal jobs
-    // from it and the central scheduling unit can push new jobs to the queue.
-    queue_type queue;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
     std::uniform_int_distribution<size_t> uniform;
     std::array<poll_strategy, 3> strategies;
-    wait_strategy waitdata;
+    // allows idle workers to block until they receive new jobs
+    detail::eventcount parking;
+    // accumulates the time idle workers spend polling for jobs
+    telemetry::dbl_counter* spinning_time;
+    // accumulates the time idle workers spend blocked
+    telemetry::dbl_counter* parked_time;
+    // maximum number of jobs a thief takes from its victim at once
+    size_t max_steal_batch;
+    // receives stolen jobs before moving them to the queue of the thief
+    std::vector<resumable*> steal_buffer;
+    // counts how often this worker tried to steal jobs
+    telemetry::int_counter* steal_attempts = nullptr;
+    // counts how often this worker stole at least one job
+    telemetry::int_counter* successful_steals = nullptr;
+    // counts how many jobs this worker stole in total
+    telemetry::int_counter* stolen_jobs = nullptr;
+    // job that runs next on this worker, bypassing the queue
+    resumable* run_next = nullptr;
+    // number of consecutive jobs this worker took from `run_next`
+    size_t run_next_streak = 0;
+    // maximum for `run_next_streak` or 0 to disable the `run_next` slot
+    size_t run_next_limit;
+    // jobs with high priority, e.g., actors with urgent messages pending
+    detail::work_stealing_queue<resumable> urgent;
+    // number of consecutive jobs this worker took from `urgent`
+    size_t urgent_streak = 0;
+    // maximum for `urgent_streak` or 0 to disable the `urgent` queue
+    size_t max_urgent_streak;
+  };
+
+  // Holds job queue of a worker and a random number generator.
+  struct worker_data : worker_state {
+    using worker_state::worker_state;
+
+    worker_data(const worker_data& other) : worker_state(other) {
+      // nop
+    }
+
+    // This queue is exposed to other workers that may attempt to steal jobs
+    // from it and the central scheduling unit can push new jobs to the queue.
+    queue_type queue;
   };
 
+  // Fetches the steal metrics for this worker.
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    auto& data = d(self);
+    init_steal_metrics(self->system().metrics(), self->id(), data);
+  }
+
   // Goes on a raid in quest for a shiny new job.
   template <class Worker>
   resumable* try_steal(Worker* self) {
     auto p = self->parent();
     if (p->num_workers() < 2) {
       // you can't steal from yourself, can you?
-      return nullptr;
+      return p->steal_from_other_domains();
     }
     // roll the dice to pick a victim other than ourselves
     auto victim = d(self).uniform(d(self).rengine);
     if (victim == self->id())
       victim = p->num_workers() - 1;
-    // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.take_tail();
+    if (auto job = steal_from(self, p->worker_by_id(victim)))
+      return job;
+    return p->steal_from_other_domains();
+  }
+
+  // Steals the oldest jobs from the queue of `victim`, up to half of its queue
+  // but no more than `max_steal_batch`. Returns the first stolen job and moves
+  // the remaining jobs to the queue of `self`.
+  template <class Worker>
+  resumable* steal_from(Worker* self, Worker* victim) {
+    auto& data = d(self);
+    auto& buf = data.steal_buffer;
+    data.steal_attempts->inc();
+    // Urgent jobs wait the longest if their worker is busy, so take them first.
+    if (!d(victim).urgent.empty()) {
+      if (auto job = d(victim).urgent.take_tail()) {
+        data.successful_steals->inc();
+        data.stolen_jobs->inc();
+        return job;
+      }
+    }
+    auto n = d(victim).queue.take_tail_batch(data.max_steal_batch, buf);
+    if (n == 0)
+      return nullptr;
+    data.successful_steals->inc();
+    data.stolen_jobs->inc(static_cast<int64_t>(n));
+    // Prepend in reverse order to run the stolen jobs in their original order.
+    for (auto i = n - 1; i > 0; --i)
+      data.queue.prepend(buf[i]);
+    auto result = buf.front();
+    buf.clear();
+    return result;
+  }
+
+  // Takes the oldest job of one of our workers, picked round-robin.
+  template <class Coordinator>
+  resumable* steal_job(Coordinator* self) {
+    auto w = self->worker_by_id(d(self).next_worker++ % self->num_workers());
+    return d(w).queue.take_tail();
   }
 
   template <class Coordinator>
@@ -95,97 +173,138 @@ public:
 
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
-    d(self).queue.append(job);
-    auto& lock = d(self).waitdata.lock;
-    auto& cv = d(self).waitdata.cv;
-    { // guard scope
-      std::unique_lock<std::mutex> guard(lock);
-      // check if the worker is sleeping
-      if (d(self).waitdata.sleeping && !d(self).queue.empty())
-        cv.notify_one();
-    }
+    auto& data = d(self);
+    if (is_urgent(data, job))
+      data.urgent.append(job);
+    else
+      data.queue.append(job);
+    // Only touches a mutex if the worker is about to fall asleep.
+    data.parking.notify_one();
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& data = d(self);
+    if (is_urgent(data, job)) {
+      data.urgent.append(job);
+      return;
+    }
+    if (data.run_next_limit == 0) {
+      data.queue.prepend(job);
+      return;
+    }
+    // The new job runs next, thieves may still steal the one it displaces.
+    if (auto prev = std::exchange(data.run_next, job))
+      data.queue.prepend(prev);
   }
 
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job) {
     // job has voluntarily released the CPU to let others run instead
     // this means we are going to put this job to the very end of our queue
-    d(self).queue.append(job);
+    auto& data = d(self);
+    if (is_urgent(data, job))
+      data.urgent.append(job);
+    else
+      data.queue.append(job);
   }
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
-    // we wait for new jobs by polling our external queue: first, we
-    // assume an active work load on the machine and perform aggressive
-    // polling, then we relax our polling a bit and wait 50 us between
-    // dequeue attempts
-    auto& strategies = d(self).strategies;
+    return dequeue(self, [this](Worker* thief) { return try_steal(thief); });
+  }
+
+  // Implements `dequeue`, calling `steal` for stealing jobs from others.
+  template <class Worker, class StealFunction>
+  resumable* dequeue(Worker* self, StealFunction steal) {
+    return dequeue(self, steal, [](timespan) { return true; });
+  }
+
+  // Implements `dequeue`, calling `steal` for stealing jobs from others. A
+  // parked worker calls `keep_waiting` with the time since it ran out of jobs
+  // whenever it wakes up without finding a job and gives up by returning
+  // `nullptr` if `keep_waiting` returns `false`.
+  template <class Worker, class StealFunction, class Predicate>
+  resumable* dequeue(Worker* self, StealFunction steal,
+                     Predicate keep_waiting) {
+    auto& data = d(self);
+    if (auto job = take_urgent(data))
+      return job;
+    if (auto job = data.run_next) {
+      data.run_next = nullptr;
+      if (data.run_next_streak < data.run_next_limit) {
+        ++data.run_next_streak;
+        return job;
+      }
+      // Two actors sending messages back and forth would otherwise starve
+      // all other jobs of this worker.
+      data.queue.append(job);
+    }
+    data.run_next_streak = 0;
+    if (auto job = data.queue.take_head()) {
+      data.urgent_streak = 0;
+      return job;
+    }
+    // We wait for new jobs by polling our queue: first, we assume an active
+    // work load on the machine and perform aggressive polling, then we yield
+    // the CPU between dequeue attempts and eventually park the worker.
+    using clock_type = std::chrono::steady_clock;
+    using fractional_seconds = std::chrono::duration<double>;
+    auto record = [](telemetry::dbl_counter* ctr, clock_type::time_point t0,
+                     clock_type::time_point t1) {
+      auto secs = std::chrono::duration_cast<fractional_seconds>(t1 - t0);
+      if (secs.count() > 0)
+        ctr->inc(secs.count());
+    };
+    auto& strategies = data.strategies;
+    auto spin_start = clock_type::now();
+    auto idle_start = spin_start;
     resumable* job = nullptr;
     for (size_t k = 0; k < 2; ++k) { // iterate over the first two strategies
       for (size_t i = 0; i < strategies[k].attempts;
            i += strategies[k].step_size) {
-        job = d(self).queue.take_head();
-        if (job)
-          return job;
+        job = take_head(data);
         // try to steal every X poll attempts
-        if ((i % strategies[k].steal_interval) == 0) {
-          job = try_steal(self);
-          if (job)
-            return job;
-        }
-        if (strategies[k].sleep_duration.count() > 0) {
-#ifdef CAF_MSVC
-          // Windows cannot sleep less than 1000 us, so timeout is converted to
-          // 0 inside sleep_for(), but Sleep(0) is dangerous so replace it with
-          // yield()
-          if (strategies[k].sleep_duration.count() < 1000)
-            std::this_thread::yield();
-          else
-            std::this_thread::sleep_for(strategies[k].sleep_duration);
-#else
-          std::this_thread::sleep_for(strategies[k].sleep_duration);
-#endif
+        if (!job && (i % strategies[k].steal_interval) == 0)
+          job = steal(self);
+        if (job) {
+          record(data.spinning_time, spin_start, clock_type::now());
+          return job;
         }
+        if (k > 0)
+          std::this_thread::yield();
       }
     }
-    // we assume pretty much nothing is going on so we can relax polling
-    // and falling to sleep on a condition variable whose timeout is the one
-    // of the relaxed polling strategy
+    // We assume pretty much nothing is going on, so we park the worker until
+    // someone enqueues a new job. Still, we wake up after the relaxed sleep
+    // duration for trying to steal jobs from other workers.
     auto& relaxed = strategies[2];
-    auto& sleeping = d(self).waitdata.sleeping;
-    auto& lock = d(self).waitdata.lock;
-    auto& cv = d(self).waitdata.cv;
-    bool notimeout = true;
-    size_t i = 1;
-    do {
-      { // guard scope
-        std::unique_lock<std::mutex> guard(lock);
-        sleeping = true;
-        if (!cv.wait_for(guard, relaxed.sleep_duration,
-                         [&] { return !d(self).queue.empty(); }))
-          notimeout = false;
-        sleeping = false;
-      }
-      if (notimeout) {
-        job = d(self).queue.take_head();
-      } else {
-        notimeout = true;
-        if ((i % relaxed.steal_interval) == 0)
-          job = try_steal(self);
+    for (size_t i = 1;; ++i) {
+      auto key = data.parking.prepare_wait();
+      job = take_head(data);
+      if (!job && (i % relaxed.steal_interval) == 0)
+        job = steal(self);
+      if (job) {
+        data.parking.cancel_wait();
+        record(data.spinning_time, spin_start, clock_type::now());
+        return job;
       }
-      ++i;
-    } while (job == nullptr);
-    return job;
+      auto park_start = clock_type::now();
+      record(data.spinning_time, spin_start, park_start);
+      data.parking.wait_for(key, relaxed.sleep_duration);
+      spin_start = clock_type::now();
+      record(data.parked_time, park_start, spin_start);
+      auto idle = spin_start - idle_start;
+      if (!keep_waiting(std::chrono::duration_cast<timespan>(idle)))
+        return nullptr;
+    }
   }
 
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
-    auto next = [&] { return d(self).queue.take_head(); };
+    if (auto job = std::exchange(d(self).run_next, nullptr))
+      f(job);
+    auto next = [&] { return take_head(d(self)); };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
     }
@@ -195,6 +314,43 @@ public:
   void foreach_central_resumable(Coordinator*, UnaryFunction) {
     // nop
   }
+
+protected:
+  // Checks whether `job` belongs to the `urgent` queue of a worker.
+  static bool is_urgent(const worker_state& data, resumable* job) {
+    return data.max_urgent_streak > 0
+           && job->priority() == message_priority::high;
+  }
+
+  // Takes the next urgent job unless the worker already ran
+  // `max_urgent_streak` urgent jobs in a row. In the latter case, the regular
+  // queue gets to run one job before the next urgent job.
+  static resumable* take_urgent(worker_state& data) {
+    if (data.urgent.empty())
+      return nullptr;
+    if (data.urgent_streak < data.max_urgent_streak) {
+      if (auto job = data.urgent.take_head()) {
+        ++data.urgent_streak;
+        return job;
+      }
+      return nullptr;
+    }
+    data.urgent_streak = 0;
+    return nullptr;
+  }
+
+  // Takes the next job from the `urgent` queue or else from the regular queue.
+  template <class WorkerData>
+  static resumable* take_head(WorkerData& data) {
+    if (!data.urgent.empty())
+      if (auto job = data.urgent.take_head())
+        return job;
+    return data.queue.take_head();
+  }
+
+private:
+  static void init_steal_metrics(telemetry::metric_registry& reg, size_t id,
+                                 worker_state& data);
 };
 
 } // namespace caf::policy
@@ -8,6 +8,7 @@
 
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/message_priority.hpp"
 
 namespace caf {
 
@@ -48,6 +49,10 @@ public:
   /// delegate other subtypes to dedicated workers.
   virtual subtype_t subtype() const;
 
+  /// Returns a priority hint for this object. This allows an execution unit
+  /// to run urgent resumables before others.
+  virtual message_priority priority() const noexcept;
+
   /// Resume any pending computation until it is either finished
   /// or needs to be re-scheduled later.
   virtual resume_result resume(execution_unit*, size_t max_throughput) = 0;
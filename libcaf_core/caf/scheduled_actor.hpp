@@ -24,7 +24,9 @@
 #include "caf/fwd.hpp"
 #include "caf/inbound_path.hpp"
 #include "caf/intrusive/drr_cached_queue.hpp"
+#include "caf/intrusive/drr_conflating_queue.hpp"
 #include "caf/intrusive/drr_queue.hpp"
+#include "caf/intrusive/drr_stashing_queue.hpp"
 #include "caf/intrusive/fifo_inbox.hpp"
 #include "caf/intrusive/wdrr_dynamic_multiplexed_queue.hpp"
 #include "caf/intrusive/wdrr_fixed_multiplexed_queue.hpp"
@@ -37,6 +39,7 @@
 #include "caf/no_stages.hpp"
 #include "caf/policy/arg.hpp"
 #include "caf/policy/categorized.hpp"
+#include "caf/policy/conflating_messages.hpp"
 #include "caf/policy/downstream_messages.hpp"
 #include "caf/policy/normal_messages.hpp"
 #include "caf/policy/upstream_messages.hpp"
@@ -114,7 +117,7 @@ public:
   using stream_manager_map = std::map<stream_slot, stream_manager_ptr>;
 
   /// Stores asynchronous messages with default priority.
-  using normal_queue = intrusive::drr_cached_queue<policy::normal_messages>;
+  using normal_queue = intrusive::drr_stashing_queue<policy::normal_messages>;
 
   /// Stores asynchronous messages with hifh priority.
   using urgent_queue = intrusive::drr_cached_queue<policy::urgent_messages>;
@@ -126,12 +129,17 @@ public:
   using downstream_queue
     = intrusive::wdrr_dynamic_multiplexed_queue<policy::downstream_messages>;
 
-  /// Configures the FIFO inbox with four nested queues:
+  /// Stores asynchronous messages that match a conflation rule.
+  using conflating_queue
+    = intrusive::drr_conflating_queue<policy::conflating_messages>;
+
+  /// Configures the FIFO inbox with five nested queues:
   ///
   ///   1. Default asynchronous messages
   ///   2. High-priority asynchronous messages
   ///   3. Upstream messages
   ///   4. Downstream messages
+  ///   5. Conflated asynchronous messages (see `conflate`)
   ///
   /// The queue for downstream messages is in turn composed of a nested queues,
   /// one for each active input slot.
@@ -144,7 +152,7 @@ public:
 
     using queue_type = intrusive::wdrr_fixed_multiplexed_queue<
       policy::categorized, urgent_queue, normal_queue, upstream_queue,
-      downstream_queue>;
+      downstream_queue, conflating_queue>;
   };
 
   static constexpr size_t urgent_queue_index = 0;
@@ -155,6 +163,9 @@ public:
 
   static constexpr size_t downstream_queue_index = 3;
 
+  static constexpr size_t conflating_queue_index
+    = policy::categorized::conflating_queue_index;
+
   /// A queue optimized for single-reader-many-writers.
   using mailbox_type = intrusive::fifo_inbox<mailbox_policy>;
 
@@ -219,6 +230,8 @@ public:
 
   void enqueue(mailbox_element_ptr ptr, execution_unit* eu) override;
 
+  void enqueue_batch(mailbox_batch what, execution_unit* eu) override;
+
   mailbox_element* peek_at_next_mailbox_element() override;
 
   // -- overridden functions of local_actor ------------------------------------
@@ -233,6 +246,8 @@ public:
 
   subtype_t subtype() const override;
 
+  message_priority priority() const noexcept override;
+
   void intrusive_ptr_add_ref_impl() override;
 
   void intrusive_ptr_release_impl() override;
@@ -266,6 +281,48 @@ public:
     return mailbox_;
   }
 
+  /// Returns the preferred NUMA node of this actor or
+  /// `actor_config::any_numa_node`.
+  size_t numa_node() const noexcept {
+    return numa_node_;
+  }
+
+  /// Sets the preferred NUMA node of this actor. Only has an effect with the
+  /// scheduler policy `numa-stealing`.
+  void set_numa_node(size_t node) noexcept {
+    numa_node_ = node;
+  }
+
+  /// Returns how long this actor may run before yielding its worker or
+  /// `infinite` if the actor only yields after `max_throughput` messages.
+  timespan max_time_slice() const noexcept {
+    return max_time_slice_;
+  }
+
+  /// Sets how long this actor may run before yielding its worker. Passing
+  /// `infinite` disables time slices for this actor.
+  void set_max_time_slice(timespan x) noexcept {
+    max_time_slice_ = x;
+  }
+
+  /// Conflates asynchronous messages that consist of a single `T`: a new
+  /// message replaces a pending message with the same key instead of queueing
+  /// behind it. The function object `f` returns the key for a `T`, which must
+  /// be equality comparable and hashable via `std::hash`. Conflated messages
+  /// keep the position of the first pending message for their key, but the
+  /// actor no longer processes them in order relative to other messages.
+  /// @note Requests and high-priority messages never conflate.
+  template <class T, class F>
+  void conflate(F f) {
+    enable_conflation().template add<T>(std::move(f));
+  }
+
+  /// Returns the scheduler domain of this actor or `nullptr` if the actor runs
+  /// on the default scheduler.
+  scheduler::abstract_coordinator* scheduler_domain() const noexcept {
+    return scheduler_domain_;
+  }
+
   /// Returns map for all active streams.
   stream_manager_map& stream_managers() noexcept {
     return stream_managers_;
@@ -286,6 +343,7 @@ public:
 
   /// Sets a custom handler for unexpected messages.
   void set_default_handler(default_handler fun) {
+    ++default_handler_version_;
     if (fun)
       default_handler_ = std::move(fun);
     else
@@ -297,6 +355,7 @@ public:
   typename std::enable_if<std::is_convertible<
     F, std::function<skippable_result(message&)>>::value>::type
   set_default_handler(F fun) {
+    ++default_handler_version_;
     default_handler_ = [=](scheduled_actor*, message& xs) { return fun(xs); };
   }
 
@@ -467,6 +526,12 @@ public:
   /// Returns the queue of the mailbox that stores `downstream_msg` messages.
   downstream_queue& get_downstream_queue();
 
+  /// Returns the queue of the mailbox that stores conflated messages.
+  conflating_queue& get_conflating_queue();
+
+  /// Deletes messages that newer messages with the same key replaced.
+  void drop_superseded_messages();
+
   // -- inbound_path management ------------------------------------------------
 
   /// Creates a new path for incoming stream traffic from `sender`.
@@ -653,6 +718,13 @@ protected:
   /// Customization point for setting a default `message` callback.
   default_handler default_handler_;
 
+  /// Changes whenever the actor replaces its default handler.
+  size_t default_handler_version_ = 0;
+
+  /// Points to the most recently skipped message if the actor only needs to
+  /// retry it after switching to a behavior that accepts its types.
+  const mailbox_element* indexable_skip_ = nullptr;
+
   /// Customization point for setting a default `error` callback.
   error_handler error_handler_;
 
@@ -682,6 +754,23 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Preferred NUMA node for running this actor.
+  size_t numa_node_;
+
+  /// Maximum time this actor may run per resume.
+  timespan max_time_slice_;
+
+  /// Scheduler domain of this actor or `nullptr` for the default scheduler.
+  scheduler::abstract_coordinator* scheduler_domain_;
+
+  /// Selects messages for the conflating queue. Only allocated after calling
+  /// `conflate` at least once.
+  std::unique_ptr<detail::conflation_rules> conflation_rules_;
+
+  /// Tells the scheduler whether this actor has urgent messages pending when
+  /// scheduling it.
+  message_priority priority_ = message_priority::normal;
+
   /// Caches metric objects for inbound stream traffic.
   inbound_stream_metrics_map inbound_stream_metrics_;
 
@@ -694,9 +783,32 @@ protected:
 #endif // CAF_ENABLE_EXCEPTIONS
 
 private:
+  friend class policy::normal_messages;
+
+  /// Schedules this actor for execution. Runs the actor on `ctx` if `ctx`
+  /// belongs to the scheduler domain of this actor.
+  void schedule(execution_unit* ctx);
+
+  /// Returns the conflation rules of this actor after making sure the mailbox
+  /// dispatches matching messages to the conflating queue.
+  detail::conflation_rules& enable_conflation();
+
+  /// Returns the types of `x` if the actor may skip messages with these types
+  /// until switching to another behavior, otherwise a null list.
+  type_id_list stash_key(const mailbox_element& x) const noexcept;
+
+  /// Returns a value that changes whenever the actor changes its behavior or
+  /// its default handler.
+  size_t stash_epoch() const noexcept {
+    return bhvr_stack_.version() + default_handler_version_;
+  }
+
+  /// Checks whether the actor may now accept messages of given types.
+  bool may_accept(type_id_list types) const noexcept;
+
   template <class F>
   intrusive::task_result run_with_metrics(mailbox_element& x, F body) {
-    if (metrics_.mailbox_time) {
+    if (metrics_.mailbox_time && x.has_enqueue_time()) {
       auto t0 = std::chrono::steady_clock::now();
       auto mbox_time = x.seconds_until(t0);
       auto res = body();
@@ -706,6 +818,12 @@ private:
         metrics_.mailbox_size->dec();
       }
       return res;
+    } else if (metrics_.mailbox_size) {
+      // Unsampled message: skip the clock reads but keep the size accurate.
+      auto res = body();
+      if (res != intrusive::task_result::skip)
+        metrics_.mailbox_size->dec();
+      return res;
     } else {
       return body();
     }
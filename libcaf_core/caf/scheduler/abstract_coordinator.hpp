@@ -7,6 +7,9 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "caf/actor.hpp"
 #include "caf/actor_addr.hpp"
@@ -16,6 +19,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
+#include "caf/telemetry/counter.hpp"
 
 namespace caf::scheduler {
 
@@ -29,6 +33,8 @@ public:
 
   explicit abstract_coordinator(actor_system& sys);
 
+  ~abstract_coordinator() override;
+
   /// Returns a handle to the central printing actor.
   actor printer() const {
     return actor_cast<actor>(utility_actors_[printer_id]);
@@ -52,10 +58,40 @@ public:
     return max_throughput_;
   }
 
+  /// Returns how long actors may run before yielding the worker or
+  /// `infinite` if actors only yield after `max_throughput` messages.
+  timespan max_time_slice() const noexcept {
+    return max_time_slice_;
+  }
+
   size_t num_workers() const {
     return num_workers_;
   }
 
+  /// Returns whether this coordinator runs a scheduler domain instead of
+  /// being the default scheduler of the actor system.
+  bool is_scheduler_domain() const noexcept {
+    return !domain_name_.empty();
+  }
+
+  /// Returns the name of the scheduler domain or an empty string for the
+  /// default scheduler.
+  const std::string& domain_name() const noexcept {
+    return domain_name_;
+  }
+
+  /// Returns the profiler of this scheduler or `nullptr` if
+  /// `caf.scheduler.enable-profiling` is `false`.
+  sampling_profiler* profiler() const noexcept {
+    return profiler_.get();
+  }
+
+  /// Returns the gauge for counting the running actors of this scheduler
+  /// domain or `nullptr` for the default scheduler.
+  telemetry::int_gauge* domain_running_actors() const noexcept {
+    return domain_running_actors_;
+  }
+
   /// Returns `true` if this scheduler detaches its utility actors.
   virtual bool detaches_utility_actors() const;
 
@@ -63,6 +99,25 @@ public:
 
   void init(actor_system_config& cfg) override;
 
+  /// Initializes this coordinator as scheduler domain `name`, reading its
+  /// parameters from `caf.scheduler.domains.<name>` with fallback to
+  /// `caf.scheduler`.
+  void init_domain(std::string name, actor_system_config& cfg);
+
+  /// Takes a job from one of the workers for running it in another scheduler
+  /// domain. Returns `nullptr` if no job is available or the scheduler does
+  /// not support stealing.
+  virtual resumable* steal_job();
+
+  /// Allows idle workers of this coordinator to steal jobs from `sources`.
+  void steal_from(std::vector<abstract_coordinator*> sources);
+
+  /// Tries to steal an actor from the scheduler domains configured via
+  /// `steal_from`.
+  resumable* steal_from_other_domains() {
+    return steal_sources_.empty() ? nullptr : steal_from_other_domains_impl();
+  }
+
   id_t id() const override;
 
   void* subtype_ptr() override;
@@ -76,15 +131,43 @@ public:
 protected:
   void stop_actors();
 
+  /// Creates and starts the profiler if `caf.scheduler.enable-profiling` is
+  /// `true`. Must run before starting the workers.
+  void start_profiler();
+
+  /// Writes all remaining samples of the profiler. Must run after stopping
+  /// the workers.
+  void stop_profiler();
+
   /// ID of the worker receiving the next enqueue (round-robin dispatch).
   std::atomic<size_t> next_worker_;
 
   /// Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_;
 
+  /// Maximum time each actor may run per resume.
+  timespan max_time_slice_;
+
   /// Configured number of workers.
   size_t num_workers_;
 
+  resumable* steal_from_other_domains_impl();
+
+  /// Name of the scheduler domain or empty for the default scheduler.
+  std::string domain_name_;
+
+  /// Coordinators our workers may steal from when running out of jobs.
+  std::vector<abstract_coordinator*> steal_sources_;
+
+  /// Counts the running actors of a scheduler domain.
+  telemetry::int_gauge* domain_running_actors_ = nullptr;
+
+  /// Counts jobs of a scheduler domain that ran in another domain.
+  telemetry::int_counter* domain_stolen_jobs_ = nullptr;
+
+  /// Samples jobs of the workers if profiling is enabled.
+  std::unique_ptr<sampling_profiler> profiler_;
+
   /// Background workers, e.g., printer.
   std::array<actor, max_id> utility_actors_;
 
@@ -46,6 +46,7 @@ public:
 
 protected:
   void start() override {
+    this->start_profiler();
     // Create initial state for all workers.
     typename worker_type::policy_data init{this};
     // Prepare workers vector.
@@ -126,6 +127,7 @@ protected:
     for (auto& w : workers_)
       policy_.foreach_resumable(w.get(), f);
     policy_.foreach_central_resumable(this, f);
+    this->stop_profiler();
     // stop timer thread
     clock_.cancel_dispatch_loop();
     timer_.join();
@@ -135,6 +137,10 @@ protected:
     policy_.central_enqueue(this, ptr);
   }
 
+  resumable* steal_job() override {
+    return policy_.steal_job(this);
+  }
+
   detail::thread_safe_actor_clock& clock() noexcept override {
     return clock_;
   }
@@ -0,0 +1,165 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/resumable.hpp"
+#include "caf/timespan.hpp"
+
+namespace caf::scheduler {
+
+/// Measures one in `sample_rate()` jobs of a scheduler. Workers store their
+/// samples in lock-free ring buffers and a background thread periodically
+/// writes them to a file in a compact binary format. The function
+/// `convert_to_trace_events` turns this file into the trace-event JSON format
+/// of Chrome.
+class CAF_CORE_EXPORT sampling_profiler {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Maximum length of actor names in samples.
+  static constexpr size_t max_name_length = 47;
+
+  /// Describes one run of a job on a worker.
+  struct sample {
+    /// ID of the worker that ran the job.
+    uint32_t worker;
+
+    /// Number of messages the job processed.
+    uint32_t messages;
+
+    /// ID of the actor or 0 if the job was not an actor.
+    actor_id id;
+
+    /// Start of the run in nanoseconds, measured by a steady clock.
+    int64_t start;
+
+    /// Duration of the run in nanoseconds.
+    int64_t duration;
+
+    /// Null-terminated and possibly truncated name of the actor.
+    char name[max_name_length + 1];
+  };
+
+  /// A single-producer, single-consumer queue with fixed capacity.
+  class CAF_CORE_EXPORT ring_buffer {
+  public:
+    /// Creates a buffer for at least `capacity` samples.
+    explicit ring_buffer(size_t capacity);
+
+    /// Stores `x` unless the buffer is full.
+    /// @returns `true` if the buffer stored `x`, `false` otherwise.
+    /// @warning Must only be called by the producer.
+    bool push(const sample& x) noexcept {
+      auto head = head_.load(std::memory_order_relaxed);
+      if (head - tail_.load(std::memory_order_acquire) > mask_)
+        return false;
+      buf_[head & mask_] = x;
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    /// Calls `f` for each stored sample in FIFO order and removes them.
+    /// @returns the number of removed samples.
+    /// @warning Must only be called by the consumer.
+    template <class F>
+    size_t drain(F f) {
+      auto tail = tail_.load(std::memory_order_relaxed);
+      auto head = head_.load(std::memory_order_acquire);
+      for (auto i = tail; i != head; ++i)
+        f(buf_[i & mask_]);
+      tail_.store(head, std::memory_order_release);
+      return head - tail;
+    }
+
+    /// Returns the maximum number of samples in the buffer.
+    size_t capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+  private:
+    std::unique_ptr<sample[]> buf_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  sampling_profiler(size_t num_workers, size_t sample_rate,
+                    size_t buffer_size);
+
+  ~sampling_profiler();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns how many jobs a worker runs per sample.
+  size_t sample_rate() const noexcept {
+    return sample_rate_;
+  }
+
+  /// Returns the number of samples that did not fit into a ring buffer.
+  size_t dropped_samples() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the ring buffer of worker `id`.
+  ring_buffer& buffer(size_t id) {
+    return *buffers_[id];
+  }
+
+  // -- sampling ---------------------------------------------------------------
+
+  /// Resumes `job` on worker `id` and stores the measurement.
+  resumable::resume_result resume(execution_unit* ctx, size_t id,
+                                  resumable* job, size_t max_throughput);
+
+  // -- output -----------------------------------------------------------------
+
+  /// Starts a background thread that writes all samples to `file_name` after
+  /// each `interval`.
+  /// @returns `false` if the profiler failed to open the file, `true`
+  ///          otherwise.
+  bool start(const std::string& file_name, timespan interval);
+
+  /// Writes all remaining samples and stops the background thread.
+  void stop();
+
+  /// Serializes all pending samples to `buf`.
+  /// @returns the number of serialized samples.
+  size_t flush(byte_buffer& buf);
+
+  /// Converts the binary output of a profiler to the trace-event JSON format
+  /// of Chrome, with one row per worker.
+  static error convert_to_trace_events(std::istream& in, std::ostream& out);
+
+private:
+  void run(timespan interval);
+
+  size_t sample_rate_;
+  std::atomic<size_t> dropped_;
+  std::vector<std::unique_ptr<ring_buffer>> buffers_;
+  std::ofstream file_;
+  std::thread flusher_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool running_ = false;
+};
+
+} // namespace caf::scheduler
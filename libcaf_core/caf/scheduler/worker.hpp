@@ -11,6 +11,7 @@
 #include "caf/execution_unit.hpp"
 #include "caf/logger.hpp"
 #include "caf/resumable.hpp"
+#include "caf/scheduler/sampling_profiler.hpp"
 
 namespace caf::scheduler {
 
@@ -32,7 +33,8 @@ public:
       id_(worker_id),
       parent_(worker_parent),
       data_(init) {
-    // nop
+    if (worker_parent->is_scheduler_domain())
+      scheduler_domain_ = worker_parent;
   }
 
   void start() {
@@ -42,6 +44,7 @@ public:
       CAF_SET_LOGGER_SYS(&this_worker->system());
       detail::set_thread_name("caf.worker");
       this_worker->system().thread_started();
+      this_worker->policy_.init_worker_thread(this_worker);
       this_worker->run();
       this_worker->system().thread_terminates();
     }};
@@ -94,13 +97,17 @@ public:
 private:
   void run() {
     CAF_SET_LOGGER_SYS(&system());
+    auto profiler = parent_->profiler();
+    size_t jobs = 0;
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
       CAF_ASSERT(job != nullptr);
       CAF_ASSERT(job->subtype() != resumable::io_actor);
       policy_.before_resume(this, job);
-      auto res = job->resume(this, max_throughput_);
+      auto res = profiler != nullptr && ++jobs % profiler->sample_rate() == 0
+                   ? profiler->resume(this, id_, job, max_throughput_)
+                   : job->resume(this, max_throughput_);
       policy_.after_resume(this, job);
       switch (res) {
         case resumable::resume_later: {
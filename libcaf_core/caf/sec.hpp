@@ -161,6 +161,8 @@ enum class sec : uint8_t {
   no_such_key = 65,
   /// An destroyed a response promise without calling deliver or delegate on it.
   broken_promise,
+  /// Disposed a message because the mailbox of the receiver was full.
+  mailbox_full,
 };
 // --(rst-sec-end)--
 
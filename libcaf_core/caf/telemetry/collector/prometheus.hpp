@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "caf/detail/core_export.hpp"
@@ -38,6 +40,19 @@ public:
     min_scrape_interval_ = value;
   }
 
+  /// Returns how many entries the collector adds to the synthesized gauge
+  /// `caf_actor_hottest_mailboxes`. A value of 0 (default) disables the gauge.
+  size_t hottest_mailboxes() const noexcept {
+    return hottest_mailboxes_;
+  }
+
+  /// Sets how many entries the collector adds to the synthesized gauge
+  /// `caf_actor_hottest_mailboxes`, i.e., the `value` instances of
+  /// `caf.actor.mailbox-size` with the most messages.
+  void hottest_mailboxes(size_t value) noexcept {
+    hottest_mailboxes_ = value;
+  }
+
   // -- collect API ------------------------------------------------------------
 
   /// Applies this collector to the registry, filling the character buffer while
@@ -83,6 +98,9 @@ private:
   void append_histogram(const metric_family* family, const metric* instance,
                         const histogram<ValueType>* val);
 
+  /// Appends the top-K instances of `caf.actor.mailbox-size` to `buf_`.
+  void append_hottest_mailboxes();
+
   /// Stores the generated text output.
   char_buffer buf_;
 
@@ -100,6 +118,13 @@ private:
 
   /// Minimum time between re-iterating the registry.
   time_t min_scrape_interval_ = 0;
+
+  /// Number of entries in `caf_actor_hottest_mailboxes`.
+  size_t hottest_mailboxes_ = 0;
+
+  /// Collects all instances of `caf.actor.mailbox-size` while iterating the
+  /// registry if `hottest_mailboxes_ > 0`.
+  std::vector<std::pair<int64_t, const metric*>> mailbox_sizes_;
 };
 
 } // namespace caf::telemetry::collector
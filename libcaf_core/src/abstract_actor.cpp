@@ -46,6 +46,11 @@ void abstract_actor::enqueue(strong_actor_ptr sender, message_id mid,
   enqueue(make_mailbox_element(sender, mid, {}, std::move(msg)), host);
 }
 
+void abstract_actor::enqueue_batch(mailbox_batch what, execution_unit* host) {
+  while (auto ptr = what.pop_front())
+    enqueue(std::move(ptr), host);
+}
+
 abstract_actor::abstract_actor(actor_config& cfg)
     : abstract_channel(cfg.flags) {
   // nop
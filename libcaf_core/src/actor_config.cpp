@@ -5,6 +5,8 @@
 #include "caf/actor_config.hpp"
 
 #include "caf/abstract_actor.hpp"
+#include "caf/deep_to_string.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
 
 namespace caf {
 
@@ -12,7 +14,12 @@ actor_config::actor_config(execution_unit* host, local_actor* parent)
   : host(host),
     parent(parent),
     flags(abstract_channel::is_abstract_actor_flag),
-    groups(nullptr) {
+    groups(nullptr),
+    numa_node(any_numa_node),
+    max_time_slice(0),
+    scheduler_domain(nullptr),
+    mailbox_capacity(0),
+    overflow_policy(mailbox_overflow_policy::drop_newest) {
   // nop
 }
 
@@ -32,6 +39,32 @@ std::string to_string(const actor_config& x) {
   add(abstract_actor::is_detached_flag, "detached_flag");
   add(abstract_actor::is_blocking_flag, "blocking_flag");
   add(abstract_actor::is_hidden_flag, "hidden_flag");
+  if (x.numa_node != actor_config::any_numa_node) {
+    if (result.back() != '(')
+      result += ", ";
+    result += "numa_node = ";
+    result += std::to_string(x.numa_node);
+  }
+  if (x.max_time_slice.count() != 0) {
+    if (result.back() != '(')
+      result += ", ";
+    result += "max_time_slice = ";
+    result += deep_to_string(x.max_time_slice);
+  }
+  if (x.scheduler_domain != nullptr) {
+    if (result.back() != '(')
+      result += ", ";
+    result += "scheduler_domain = ";
+    result += x.scheduler_domain->domain_name();
+  }
+  if (x.mailbox_capacity != 0) {
+    if (result.back() != '(')
+      result += ", ";
+    result += "mailbox_capacity = ";
+    result += std::to_string(x.mailbox_capacity);
+    result += ", overflow_policy = ";
+    result += to_string(x.overflow_policy);
+  }
   result += ')';
   return result;
 }
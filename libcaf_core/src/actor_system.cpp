@@ -4,6 +4,7 @@
 
 #include "caf/actor_system.hpp"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "caf/actor.hpp"
@@ -11,6 +12,9 @@
 #include "caf/defaults.hpp"
 #include "caf/detail/meta_object.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/policy/elastic_work_stealing.hpp"
+#include "caf/policy/locking_work_stealing.hpp"
+#include "caf/policy/numa_work_stealing.hpp"
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
 #include "caf/raise_error.hpp"
@@ -214,6 +218,10 @@ auto make_base_metrics(telemetry::metric_registry& reg) {
                         "Number of currently running actors."),
     reg.gauge_singleton("caf.system", "queued-messages",
                         "Number of messages in all mailboxes.", "1", true),
+    reg.counter_family("caf.system", "mailbox-overflows", {"policy"},
+                       "Number of messages that exceeded the capacity of a "
+                       "bounded mailbox.",
+                       "1", true),
   };
 }
 
@@ -243,6 +251,10 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       "Time a message waits in the mailbox before processing.", "seconds"),
     reg.gauge_family("caf.actor", "mailbox-size", {"name"},
                      "Number of messages in the mailbox."),
+    reg.gauge_family("caf.actor", "stash-size", {"name"},
+                     "Number of skipped messages in the stash."),
+    reg.counter_family("caf.actor", "stash-retries", {"name"},
+                       "Number of retried skipped messages."),
     {
       reg.counter_family("caf.actor.stream", "processed-elements",
                          {"name", "type"},
@@ -260,6 +272,60 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
   };
 }
 
+// Creates a scheduler for the given policy name.
+scheduler::abstract_coordinator* make_coordinator(actor_system& sys,
+                                                  string_view sr_policy) {
+  using namespace scheduler;
+  using policy::elastic_work_stealing;
+  using policy::locking_work_stealing;
+  using policy::numa_work_stealing;
+  using policy::work_sharing;
+  using policy::work_stealing;
+  using share = coordinator<work_sharing>;
+  using steal = coordinator<work_stealing>;
+  using locking_steal = coordinator<locking_work_stealing>;
+  using numa_steal = coordinator<numa_work_stealing>;
+  using elastic_steal = coordinator<elastic_work_stealing>;
+  enum sched_conf {
+    stealing = 0x0001,
+    sharing = 0x0002,
+    testing = 0x0003,
+    locking_stealing = 0x0004,
+    numa_stealing = 0x0005,
+    elastic_stealing = 0x0006,
+  };
+  sched_conf sc = stealing;
+  if (sr_policy == "sharing")
+    sc = sharing;
+  else if (sr_policy == "testing")
+    sc = testing;
+  else if (sr_policy == "locking-stealing")
+    sc = locking_stealing;
+  else if (sr_policy == "numa-stealing")
+    sc = numa_stealing;
+  else if (sr_policy == "elastic-stealing")
+    sc = elastic_stealing;
+  else if (sr_policy != "stealing")
+    std::cerr << "[WARNING] " << deep_to_string(sr_policy)
+              << " is an unrecognized scheduler pollicy, "
+                 "falling back to 'stealing' (i.e. work-stealing)"
+              << std::endl;
+  switch (sc) {
+    default: // any invalid configuration falls back to work stealing
+      return new steal(sys);
+    case sharing:
+      return new share(sys);
+    case testing:
+      return new test_coordinator(sys);
+    case locking_stealing:
+      return new locking_steal(sys);
+    case numa_stealing:
+      return new numa_steal(sys);
+    case elastic_stealing:
+      return new elastic_steal(sys);
+  }
+}
+
 } // namespace
 
 actor_system::actor_system(actor_system_config& cfg)
@@ -287,6 +353,8 @@ actor_system::actor_system(actor_system_config& cfg)
   if (auto lst = get_as<string_list>(cfg,
                                      "caf.metrics-filters.actors.excludes"))
     metrics_actors_excludes_ = std::move(*lst);
+  if (auto rate = get_as<size_t>(cfg, "caf.metrics-filters.actors.sample-rate"))
+    metrics_actors_sample_rate_ = std::max(*rate, size_t{1});
   if (!metrics_actors_includes_.empty())
     actor_metric_families_ = make_actor_metric_families(metrics_);
   // Spin up modules.
@@ -310,40 +378,9 @@ actor_system::actor_system(actor_system_config& cfg)
   }
   // Make sure we have a scheduler up and running.
   auto& sched = modules_[module::scheduler];
-  using namespace scheduler;
-  using policy::work_sharing;
-  using policy::work_stealing;
-  using share = coordinator<work_sharing>;
-  using steal = coordinator<work_stealing>;
-  if (!sched) {
-    enum sched_conf {
-      stealing = 0x0001,
-      sharing = 0x0002,
-      testing = 0x0003,
-    };
-    sched_conf sc = stealing;
-    namespace sr = defaults::scheduler;
-    auto sr_policy = get_or(cfg, "caf.scheduler.policy", sr::policy);
-    if (sr_policy == "sharing")
-      sc = sharing;
-    else if (sr_policy == "testing")
-      sc = testing;
-    else if (sr_policy != "stealing")
-      std::cerr << "[WARNING] " << deep_to_string(sr_policy)
-                << " is an unrecognized scheduler pollicy, "
-                   "falling back to 'stealing' (i.e. work-stealing)"
-                << std::endl;
-    switch (sc) {
-      default: // any invalid configuration falls back to work stealing
-        sched.reset(new steal(*this));
-        break;
-      case sharing:
-        sched.reset(new share(*this));
-        break;
-      case testing:
-        sched.reset(new test_coordinator(*this));
-    }
-  }
+  if (!sched)
+    sched.reset(make_coordinator(*this, get_or(cfg, "caf.scheduler.policy",
+                                               defaults::scheduler::policy)));
   // Initialize state for each module and give each module the opportunity to
   // adapt the system configuration.
   logger_->init(cfg);
@@ -352,6 +389,40 @@ actor_system::actor_system(actor_system_config& cfg)
     if (mod)
       mod->init(cfg);
   groups_.init(cfg);
+  // Create additional schedulers for each configured domain.
+  if (auto domains = get_if<settings>(&cfg, "caf.scheduler.domains")) {
+    auto default_policy = get_or(cfg, "caf.scheduler.policy",
+                                 defaults::scheduler::policy);
+    for (auto& kvp : *domains) {
+      auto key = "caf.scheduler.domains." + kvp.first + ".policy";
+      auto domain = make_coordinator(*this,
+                                     get_or(cfg, key, default_policy));
+      domain->init_domain(kvp.first, cfg);
+      scheduler_domains_.emplace_back(domain);
+    }
+    // Wire up stealing between schedulers once all domains exist.
+    auto wire = [this, &cfg](scheduler::abstract_coordinator* thief,
+                             string_view key) {
+      std::vector<scheduler::abstract_coordinator*> sources;
+      for (auto& src_name : get_or(cfg, key, string_list{})) {
+        auto src = src_name == "default" ? &scheduler()
+                                         : scheduler_domain(src_name);
+        if (src != nullptr && src != thief)
+          sources.emplace_back(src);
+        else
+          CAF_LOG_WARNING("cannot steal from scheduler domain:" << src_name);
+      }
+      if (!sources.empty())
+        thief->steal_from(std::move(sources));
+    };
+    wire(&scheduler(), "caf.scheduler.steal-from");
+    for (auto& ptr : scheduler_domains_) {
+      auto domain = static_cast<scheduler::abstract_coordinator*>(
+        ptr->subtype_ptr());
+      wire(domain, "caf.scheduler.domains." + domain->domain_name()
+                     + ".steal-from");
+    }
+  }
   // Spawn config and spawn servers (lazily to not access the scheduler yet).
   static constexpr auto Flags = hidden + lazy_init;
   spawn_serv(actor_cast<strong_actor_ptr>(spawn<Flags>(spawn_serv_impl)));
@@ -364,6 +435,8 @@ actor_system::actor_system(actor_system_config& cfg)
   for (auto& mod : modules_)
     if (mod)
       mod->start();
+  for (auto& domain : scheduler_domains_)
+    domain->start();
   groups_.start();
   logger_->start();
 }
@@ -385,6 +458,9 @@ actor_system::~actor_system() {
     registry_.erase("ConfigServ");
     // group module is the first one, relies on MM
     groups_.stop();
+    // scheduler domains depend on the clock of the default scheduler
+    for (auto& domain : scheduler_domains_)
+      domain->stop();
     // stop modules in reverse order
     for (auto i = modules_.rbegin(); i != modules_.rend(); ++i) {
       auto& ptr = *i;
@@ -410,6 +486,26 @@ scheduler::abstract_coordinator& actor_system::scheduler() {
   return *static_cast<ptr>(modules_[module::scheduler].get());
 }
 
+scheduler::abstract_coordinator*
+actor_system::scheduler_domain(string_view name) {
+  for (auto& ptr : scheduler_domains_) {
+    auto domain = static_cast<scheduler::abstract_coordinator*>(
+      ptr->subtype_ptr());
+    if (domain->domain_name() == name)
+      return domain;
+  }
+  return nullptr;
+}
+
+scheduler::abstract_coordinator*
+actor_system::domain_or_default(string_view name) {
+  auto result = scheduler_domain(name);
+  if (result == nullptr)
+    CAF_LOG_WARNING("unknown scheduler domain, using the default scheduler:"
+                    << name);
+  return result;
+}
+
 caf::logger& actor_system::logger() {
   return *logger_;
 }
@@ -70,12 +70,17 @@ actor_system_config::actor_system_config()
     .add<int32_t>("batch-size", "number of elements per batch")
     .add<int32_t>("buffer-size", "max. number of elements in the input buffer");
   opt_group{custom_options_, "caf.scheduler"}
-    .add<string>("policy", "'stealing' (default) or 'sharing'")
+    .add<string>("policy", "'stealing' (default), 'locking-stealing', "
+                           "'numa-stealing', 'elastic-stealing' or 'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput", "nr. of messages actors can consume per run")
+    .add<timespan>("max-time-slice",
+                   "max. time actors can run per run (0 = unlimited)")
     .add<bool>("enable-profiling", "enables profiler output")
-    .add<timespan>("profiling-resolution", "data collection rate")
-    .add<string>("profiling-output-file", "output file for the profiler");
+    .add<timespan>("profiling-resolution", "interval for writing samples")
+    .add<string>("profiling-output-file", "output file for the profiler")
+    .add<size_t>("profiling-sample-rate", "nr. of jobs per profiler sample")
+    .add<size_t>("profiling-buffer-size", "max. nr. of pending samples");
   opt_group(custom_options_, "caf.work-stealing")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
@@ -84,11 +89,29 @@ actor_system_config::actor_system_config()
     .add<size_t>("moderate-steal-interval",
                  "frequency of moderate steal attempts")
     .add<timespan>("moderate-sleep-duration",
-                   "sleep duration between moderate steal attempts")
+                   "deprecated (workers yield between moderate steal "
+                   "attempts)")
     .add<size_t>("relaxed-steal-interval",
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+                   "max. time parked workers wait before stealing")
+    .add<size_t>("max-steal-batch", "max. nr. of jobs stolen at once")
+    .add<size_t>("run-next-limit",
+                 "max. nr. of consecutive jobs skipping the queue (0 = off)")
+    .add<size_t>("max-urgent-streak",
+                 "max. nr. of consecutive high-priority jobs (0 = off)");
+  opt_group(custom_options_, "caf.numa-stealing")
+    .add<string>("cpu-list", "CPUs for the workers, e.g., '0-3,8-11'")
+    .add<bool>("pin-workers", "binds each worker to one CPU")
+    .add<size_t>("inter-node-steal-interval",
+                 "frequency of steal attempts on other NUMA nodes");
+  opt_group(custom_options_, "caf.elastic-stealing")
+    .add<size_t>("min-threads", "min. nr. of active workers")
+    .add<size_t>("grow-threshold",
+                 "nr. of queued jobs that activates another worker")
+    .add<timespan>("grow-interval", "min. time between activating workers")
+    .add<timespan>("idle-timeout",
+                   "time after which idle workers become inactive");
   opt_group{custom_options_, "caf.logger"} //
     .add<bool>("inline-output", "disable logger thread (for testing only!)");
   opt_group{custom_options_, "caf.logger.file"}
@@ -120,10 +143,16 @@ settings actor_system_config::dump_content() const {
   put_missing(scheduler_group, "policy", defaults::scheduler::policy);
   put_missing(scheduler_group, "max-throughput",
               defaults::scheduler::max_throughput);
+  put_missing(scheduler_group, "max-time-slice",
+              defaults::scheduler::max_time_slice);
   put_missing(scheduler_group, "enable-profiling", false);
   put_missing(scheduler_group, "profiling-resolution",
               defaults::scheduler::profiling_resolution);
   put_missing(scheduler_group, "profiling-output-file", std::string{});
+  put_missing(scheduler_group, "profiling-sample-rate",
+              defaults::scheduler::profiling_sample_rate);
+  put_missing(scheduler_group, "profiling-buffer-size",
+              defaults::scheduler::profiling_buffer_size);
   // -- work-stealing parameters
   auto& work_stealing_group = caf_group["work-stealing"].as_dictionary();
   put_missing(work_stealing_group, "aggressive-poll-attempts",
@@ -134,12 +163,34 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::moderate_poll_attempts);
   put_missing(work_stealing_group, "moderate-steal-interval",
               defaults::work_stealing::moderate_steal_interval);
-  put_missing(work_stealing_group, "moderate-sleep-duration",
-              defaults::work_stealing::moderate_sleep_duration);
   put_missing(work_stealing_group, "relaxed-steal-interval",
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "max-steal-batch",
+              defaults::work_stealing::max_steal_batch);
+  put_missing(work_stealing_group, "run-next-limit",
+              defaults::work_stealing::run_next_limit);
+  put_missing(work_stealing_group, "max-urgent-streak",
+              defaults::work_stealing::max_urgent_streak);
+  // -- NUMA-aware work-stealing parameters
+  auto& numa_stealing_group = caf_group["numa-stealing"].as_dictionary();
+  put_missing(numa_stealing_group, "cpu-list",
+              defaults::numa_stealing::cpu_list);
+  put_missing(numa_stealing_group, "pin-workers",
+              defaults::numa_stealing::pin_workers);
+  put_missing(numa_stealing_group, "inter-node-steal-interval",
+              defaults::numa_stealing::inter_node_steal_interval);
+  // -- elastic work-stealing parameters
+  auto& elastic_stealing_group = caf_group["elastic-stealing"].as_dictionary();
+  put_missing(elastic_stealing_group, "min-threads",
+              defaults::elastic_stealing::min_threads);
+  put_missing(elastic_stealing_group, "grow-threshold",
+              defaults::elastic_stealing::grow_threshold);
+  put_missing(elastic_stealing_group, "grow-interval",
+              defaults::elastic_stealing::grow_interval);
+  put_missing(elastic_stealing_group, "idle-timeout",
+              defaults::elastic_stealing::idle_timeout);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   put_missing(logger_group, "inline-output", false);
@@ -50,13 +50,16 @@ blocking_actor::~blocking_actor() {
   // avoid weak-vtables warning
 }
 
-void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
+void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_ASSERT(ptr != nullptr);
   CAF_ASSERT(getf(is_blocking_flag));
   CAF_LOG_TRACE(CAF_ARG(*ptr));
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto src = ptr->sender;
+  auto bounded = is_bounded(*ptr);
+  if (bounded && !reserve_mailbox_slot(*ptr, eu))
+    return;
   auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
   if (collects_metrics) {
     ptr->set_enqueue_time();
@@ -68,6 +71,8 @@ void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
     home_system().base_metrics().rejected_messages->inc();
     if (collects_metrics)
       metrics_.mailbox_size->dec();
+    if (bounded)
+      release_mailbox_slot();
     if (mid.is_request()) {
       detail::sync_request_bouncer srb{exit_reason()};
       srb(src, mid);
@@ -184,6 +189,12 @@ void blocking_actor::fail_state(error err) {
 intrusive::task_result
 blocking_actor::mailbox_visitor::operator()(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
+  auto bounded = self->is_bounded(x);
+  if (bounded && self->discard_oldest()) {
+    if (self->getf(abstract_actor::collects_metrics_flag))
+      self->builtin_metrics().mailbox_size->dec();
+    return intrusive::task_result::resume;
+  }
   CAF_LOG_RECEIVE_EVENT((&x));
   CAF_BEFORE_PROCESSING(self, x);
   // Wrap the actual body for the function.
@@ -247,6 +258,8 @@ blocking_actor::mailbox_visitor::operator()(mailbox_element& x) {
     } else {
       CAF_AFTER_PROCESSING(self, invoke_message_result::consumed);
       CAF_LOG_FINALIZE_EVENT();
+      if (bounded)
+        self->release_mailbox_slot();
     }
     return result;
   } else {
@@ -263,6 +276,8 @@ blocking_actor::mailbox_visitor::operator()(mailbox_element& x) {
     } else {
       CAF_AFTER_PROCESSING(self, invoke_message_result::consumed);
       CAF_LOG_FINALIZE_EVENT();
+      if (bounded)
+        self->release_mailbox_slot();
     }
     return result;
   }
@@ -314,14 +329,21 @@ bool blocking_actor::await_data(timeout_type timeout) {
 
 mailbox_element_ptr blocking_actor::dequeue() {
   mailbox().flush_cache();
-  await_data();
-  mailbox().fetch_more();
-  auto& qs = mailbox().queue().queues();
-  auto result = get<mailbox_policy::urgent_queue_index>(qs).take_front();
-  if (!result)
-    result = get<mailbox_policy::normal_queue_index>(qs).take_front();
-  CAF_ASSERT(result != nullptr);
-  return result;
+  for (;;) {
+    await_data();
+    mailbox().fetch_more();
+    auto& qs = mailbox().queue().queues();
+    auto result = get<mailbox_policy::urgent_queue_index>(qs).take_front();
+    if (!result)
+      result = get<mailbox_policy::normal_queue_index>(qs).take_front();
+    CAF_ASSERT(result != nullptr);
+    if (!is_bounded(*result))
+      return result;
+    if (!discard_oldest()) {
+      release_mailbox_slot();
+      return result;
+    }
+  }
 }
 
 void blocking_actor::varargs_tup_receive(receive_cond& rcc, message_id mid,
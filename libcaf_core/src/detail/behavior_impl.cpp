@@ -18,6 +18,10 @@ public:
     return first->invoke(f, xs) || second->invoke(f, xs);
   }
 
+  bool accepts(type_id_list types) const noexcept override {
+    return first->accepts(types) || second->accepts(types);
+  }
+
   void handle_timeout() override {
     // the second behavior overrides the timeout handling of
     // first behavior
@@ -73,6 +77,10 @@ optional<message> behavior_impl::invoke(message& xs) {
   return none;
 }
 
+bool behavior_impl::accepts(type_id_list) const noexcept {
+  return true;
+}
+
 void behavior_impl::handle_timeout() {
   // nop
 }
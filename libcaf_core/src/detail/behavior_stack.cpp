@@ -12,12 +12,14 @@ namespace caf::detail {
 
 void behavior_stack::pop_back() {
   CAF_ASSERT(!elements_.empty());
+  ++version_;
   erased_elements_.push_back(std::move(elements_.back()));
   elements_.pop_back();
 }
 
 void behavior_stack::clear() {
   if (!elements_.empty()) {
+    ++version_;
     if (erased_elements_.empty()) {
       elements_.swap(erased_elements_);
     } else {
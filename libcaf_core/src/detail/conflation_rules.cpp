@@ -0,0 +1,34 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/conflation_rules.hpp"
+
+#include <algorithm>
+
+namespace caf::detail {
+
+conflation_rules::rule::~rule() {
+  // nop
+}
+
+void conflation_rules::add(type_id_t type, rule_ptr ptr) {
+  auto pred = [type](const auto& x) { return x.first == type; };
+  auto i = std::find_if(rules_.begin(), rules_.end(), pred);
+  if (i != rules_.end())
+    i->second = std::move(ptr);
+  else
+    rules_.emplace_back(type, std::move(ptr));
+}
+
+auto conflation_rules::find(const message& x) const noexcept -> const rule* {
+  if (rules_.empty() || x.size() != 1)
+    return nullptr;
+  auto type = x.type_at(0);
+  for (auto& [id, ptr] : rules_)
+    if (id == type)
+      return ptr.get();
+  return nullptr;
+}
+
+} // namespace caf::detail
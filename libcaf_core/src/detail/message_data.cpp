@@ -18,7 +18,15 @@
 namespace caf::detail {
 
 message_data::message_data(type_id_list types) noexcept
-  : rc_(1), types_(std::move(types)), constructed_elements_(0) {
+  : message_data(std::move(types), false) {
+  // nop
+}
+
+message_data::message_data(type_id_list types, bool embedded) noexcept
+  : rc_(1),
+    types_(std::move(types)),
+    constructed_elements_(0),
+    embedded_(embedded) {
   // nop
 }
 
@@ -45,8 +53,7 @@ message_data* message_data::copy() const {
   size_t storage_size = 0;
   for (auto id : types_)
     storage_size += gmos[id].padded_size;
-  auto total_size = sizeof(message_data) + storage_size;
-  auto vptr = malloc(total_size);
+  auto vptr = allocate(storage_size);
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   intrusive_ptr<message_data> ptr{new (vptr) message_data(types_), false};
@@ -68,8 +75,7 @@ message_data::make_uninitialized(type_id_list types) {
   size_t storage_size = 0;
   for (auto id : types)
     storage_size += gmos[id].padded_size;
-  auto total_size = sizeof(message_data) + storage_size;
-  auto vptr = malloc(total_size);
+  auto vptr = allocate(storage_size);
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   return {new (vptr) message_data(types), false};
@@ -0,0 +1,119 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/numa_topology.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <thread>
+
+namespace caf::detail {
+
+namespace {
+
+// Reads the first line of a file in sysfs.
+optional<std::string> read_line(const std::string& path) {
+  std::ifstream in{path};
+  std::string result;
+  if (!in || !std::getline(in, result))
+    return none;
+  return result;
+}
+
+// Parses a non-negative integer and advances `first`.
+optional<int> parse_cpu(const char*& first, const char* last) {
+  if (first == last || *first < '0' || *first > '9')
+    return none;
+  int result = 0;
+  for (; first != last && *first >= '0' && *first <= '9'; ++first)
+    result = result * 10 + (*first - '0');
+  return result;
+}
+
+} // namespace
+
+numa_topology::numa_topology(std::vector<node> nodes)
+  : nodes_(std::move(nodes)) {
+  // nop
+}
+
+numa_topology numa_topology::load() {
+  if (auto result = load("/sys/devices/system/node"))
+    return std::move(*result);
+  node single{0, {}};
+  auto n = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+  for (int cpu = 0; cpu < n; ++cpu)
+    single.cpus.emplace_back(cpu);
+  std::vector<node> nodes;
+  nodes.emplace_back(std::move(single));
+  return numa_topology{std::move(nodes)};
+}
+
+optional<numa_topology> numa_topology::load(const std::string& path) {
+  auto online = read_line(path + "/online");
+  if (!online)
+    return none;
+  auto ids = parse_cpu_list(*online);
+  if (!ids || ids->empty())
+    return none;
+  std::vector<node> nodes;
+  for (auto id : *ids) {
+    auto str = read_line(path + "/node" + std::to_string(id) + "/cpulist");
+    if (!str)
+      return none;
+    auto cpus = parse_cpu_list(*str);
+    if (!cpus)
+      return none;
+    // Skip memory-only nodes.
+    if (!cpus->empty())
+      nodes.emplace_back(node{static_cast<size_t>(id), std::move(*cpus)});
+  }
+  if (nodes.empty())
+    return none;
+  return numa_topology{std::move(nodes)};
+}
+
+std::vector<int> numa_topology::cpus() const {
+  std::vector<int> result;
+  for (auto& x : nodes_)
+    result.insert(result.end(), x.cpus.begin(), x.cpus.end());
+  return result;
+}
+
+optional<size_t> numa_topology::node_of(int cpu) const noexcept {
+  for (auto& x : nodes_)
+    if (std::binary_search(x.cpus.begin(), x.cpus.end(), cpu))
+      return x.id;
+  return none;
+}
+
+optional<std::vector<int>> parse_cpu_list(string_view str) {
+  std::vector<int> result;
+  auto first = str.data();
+  auto last = first + str.size();
+  // Ignore trailing whitespace, e.g., the newline when reading from sysfs.
+  while (first != last && std::isspace(static_cast<unsigned char>(last[-1])))
+    --last;
+  while (first != last) {
+    auto lower = parse_cpu(first, last);
+    if (!lower)
+      return none;
+    auto upper = lower;
+    if (first != last && *first == '-') {
+      upper = parse_cpu(++first, last);
+      if (!upper || *upper < *lower)
+        return none;
+    }
+    for (auto cpu = *lower; cpu <= *upper; ++cpu)
+      result.emplace_back(cpu);
+    if (first != last && (*first != ',' || ++first == last))
+      return none;
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+} // namespace caf::detail
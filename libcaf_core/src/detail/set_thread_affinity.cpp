@@ -0,0 +1,30 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/set_thread_affinity.hpp"
+
+#include "caf/config.hpp"
+
+#ifdef CAF_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif // CAF_LINUX
+
+namespace caf::detail {
+
+bool set_thread_affinity(int cpu) {
+#ifdef CAF_LINUX
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+#else // CAF_LINUX
+  CAF_IGNORE_UNUSED(cpu);
+  return false;
+#endif // CAF_LINUX
+}
+
+} // namespace caf::detail
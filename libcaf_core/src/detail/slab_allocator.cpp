@@ -0,0 +1,254 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "caf/config.hpp"
+
+#ifdef CAF_WINDOWS
+#  include <malloc.h>
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+// -- memory layout ------------------------------------------------------------
+
+struct heap;
+
+// Intrusive list node for free blocks.
+struct block {
+  block* next;
+};
+
+// Sits at the beginning of each slab. Since slabs are aligned to their size,
+// we can find the header for any block by masking its address.
+struct alignas(64) slab_header {
+  heap* owner;
+  size_t block_size;
+};
+
+static_assert(sizeof(slab_header) == 64);
+
+// Allocation state of a thread for a single size class.
+struct size_class_state {
+  // Blocks released by the owner.
+  block* free_list = nullptr;
+
+  // Unused region of the current slab.
+  char* bump = nullptr;
+
+  // End of the current slab.
+  char* bump_end = nullptr;
+
+  // Blocks released by other threads. Separate cache line, since other
+  // threads write to it.
+  alignas(64) std::atomic<block*> remote{nullptr};
+};
+
+// Allocation state of a thread. Owned by a single thread at a time.
+struct heap {
+  size_class_state classes[slab_allocator::num_size_classes];
+
+  // Only the owner writes to the counters, other threads merely read them.
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> system_allocations{0};
+};
+
+void increment(std::atomic<size_t>& counter) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+void* allocate_slab() noexcept {
+#ifdef CAF_WINDOWS
+  return _aligned_malloc(slab_allocator::slab_size, slab_allocator::slab_size);
+#else
+  void* result = nullptr;
+  if (posix_memalign(&result, slab_allocator::slab_size,
+                     slab_allocator::slab_size)
+      != 0)
+    return nullptr;
+  return result;
+#endif
+}
+
+slab_header* slab_of(void* ptr) noexcept {
+  auto addr = reinterpret_cast<uintptr_t>(ptr);
+  return reinterpret_cast<slab_header*>(
+    addr & ~static_cast<uintptr_t>(slab_allocator::slab_size - 1));
+}
+
+// -- heap management ----------------------------------------------------------
+
+// Keeps track of all heaps. Leaked on purpose, because threads may release
+// memory during static destruction.
+struct heap_registry {
+  std::mutex mtx;
+
+  // All heaps ever created, used for collecting statistics.
+  std::vector<heap*> heaps;
+
+  // Heaps of threads that have exited.
+  std::vector<heap*> abandoned;
+
+  // Serves threads that allocate memory while shutting down. Guarded by `mtx`.
+  heap* fallback = nullptr;
+
+  static heap_registry& instance() {
+    static auto ptr = new heap_registry;
+    return *ptr;
+  }
+
+  heap* acquire() {
+    std::unique_lock<std::mutex> guard{mtx};
+    if (!abandoned.empty()) {
+      auto result = abandoned.back();
+      abandoned.pop_back();
+      return result;
+    }
+    auto result = new heap;
+    heaps.emplace_back(result);
+    return result;
+  }
+
+  void release(heap* ptr) {
+    std::unique_lock<std::mutex> guard{mtx};
+    abandoned.emplace_back(ptr);
+  }
+};
+
+// The heap of the current thread. A plain pointer, so that checking for the
+// owner of a block remains cheap.
+thread_local heap* tl_heap = nullptr;
+
+// Set when the current thread has released its heap.
+thread_local bool tl_exited = false;
+
+// Hands the heap of a thread over to the registry when the thread exits.
+struct heap_guard {
+  heap* ptr = nullptr;
+
+  ~heap_guard() {
+    if (ptr != nullptr) {
+      tl_heap = nullptr;
+      tl_exited = true;
+      heap_registry::instance().release(ptr);
+    }
+  }
+};
+
+thread_local heap_guard tl_guard;
+
+heap* local_heap() {
+  if (tl_heap == nullptr) {
+    tl_heap = heap_registry::instance().acquire();
+    tl_guard.ptr = tl_heap;
+  }
+  return tl_heap;
+}
+
+// -- allocation ---------------------------------------------------------------
+
+void* allocate_from(heap* h, size_t index) noexcept {
+  auto& cls = h->classes[index];
+  increment(h->allocations);
+  if (cls.free_list == nullptr
+      && cls.remote.load(std::memory_order_relaxed) != nullptr)
+    cls.free_list = cls.remote.exchange(nullptr, std::memory_order_acquire);
+  if (auto ptr = cls.free_list) {
+    cls.free_list = ptr->next;
+    return ptr;
+  }
+  auto size = slab_allocator::block_size(index);
+  if (cls.bump == cls.bump_end) {
+    auto slab = allocate_slab();
+    if (slab == nullptr)
+      return nullptr;
+    increment(h->system_allocations);
+    auto hdr = new (slab) slab_header;
+    hdr->owner = h;
+    hdr->block_size = size;
+    cls.bump = reinterpret_cast<char*>(slab) + sizeof(slab_header);
+    cls.bump_end = reinterpret_cast<char*>(slab) + slab_allocator::slab_size;
+  }
+  auto result = cls.bump;
+  cls.bump += size;
+  return result;
+}
+
+void push_remote(size_class_state& cls, block* ptr) noexcept {
+  auto head = cls.remote.load(std::memory_order_relaxed);
+  do {
+    ptr->next = head;
+  } while (!cls.remote.compare_exchange_weak(head, ptr,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+}
+
+} // namespace
+
+// -- allocation ---------------------------------------------------------------
+
+void* slab_allocator::allocate(size_t size) noexcept {
+  if (size > max_block_size) {
+    if (!tl_exited) {
+      auto h = local_heap();
+      increment(h->allocations);
+      increment(h->system_allocations);
+    }
+    return malloc(size);
+  }
+  if (!tl_exited)
+    return allocate_from(local_heap(), size_class(size));
+  auto& reg = heap_registry::instance();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  if (reg.fallback == nullptr) {
+    reg.fallback = new heap;
+    reg.heaps.emplace_back(reg.fallback);
+  }
+  return allocate_from(reg.fallback, size_class(size));
+}
+
+void slab_allocator::deallocate(void* ptr, size_t size) noexcept {
+  if (ptr == nullptr)
+    return;
+  if (size > max_block_size) {
+    free(ptr);
+    return;
+  }
+  auto hdr = slab_of(ptr);
+  auto blk = reinterpret_cast<block*>(ptr);
+  auto& cls = hdr->owner->classes[size_class(hdr->block_size)];
+  if (hdr->owner == tl_heap) {
+    blk->next = cls.free_list;
+    cls.free_list = blk;
+  } else {
+    push_remote(cls, blk);
+  }
+}
+
+// -- properties ---------------------------------------------------------------
+
+slab_allocator::statistics slab_allocator::stats() noexcept {
+  statistics result{0, 0};
+  auto& reg = heap_registry::instance();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  for (auto h : reg.heaps) {
+    result.allocations += h->allocations.load(std::memory_order_relaxed);
+    result.system_allocations
+      += h->system_allocations.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+} // namespace caf::detail
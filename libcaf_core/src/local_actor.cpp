@@ -5,6 +5,7 @@
 #include "caf/local_actor.hpp"
 
 #include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include "caf/actor_cast.hpp"
@@ -16,9 +17,11 @@
 #include "caf/detail/glob_match.hpp"
 #include "caf/exit_reason.hpp"
 #include "caf/logger.hpp"
+#include "caf/mailbox_element.hpp"
 #include "caf/resumable.hpp"
 #include "caf/scheduler.hpp"
 #include "caf/sec.hpp"
+#include "caf/telemetry/counter.hpp"
 
 namespace caf {
 
@@ -39,6 +42,8 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
       nullptr,
       nullptr,
       nullptr,
+      nullptr,
+      nullptr,
     };
   self->setf(abstract_actor::collects_metrics_flag);
   const auto& families = sys.actor_metric_families();
@@ -47,17 +52,48 @@ local_actor::metrics_t make_instance_metrics(local_actor* self) {
     families.processing_time->get_or_add({{"name", sv}}),
     families.mailbox_time->get_or_add({{"name", sv}}),
     families.mailbox_size->get_or_add({{"name", sv}}),
+    families.stash_size->get_or_add({{"name", sv}}),
+    families.stash_retries->get_or_add({{"name", sv}}),
   };
 }
 
+string_view overflow_policy_label(mailbox_overflow_policy x) {
+  switch (x) {
+    default:
+      return "drop-newest";
+    case mailbox_overflow_policy::drop_oldest:
+      return "drop-oldest";
+    case mailbox_overflow_policy::reject:
+      return "reject";
+    case mailbox_overflow_policy::block:
+      return "block";
+  }
+}
+
 } // namespace
 
+struct local_actor::blocked_senders {
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool closed = false;
+};
+
 local_actor::local_actor(actor_config& cfg)
   : monitorable_actor(cfg),
     context_(cfg.host),
     current_element_(nullptr),
-    initial_behavior_fac_(std::move(cfg.init_fun)) {
-  // nop
+    initial_behavior_fac_(std::move(cfg.init_fun)),
+    mailbox_capacity_(cfg.mailbox_capacity),
+    overflow_policy_(cfg.overflow_policy),
+    bounded_messages_(0),
+    mailbox_overflows_(nullptr) {
+  if (mailbox_capacity_ > 0) {
+    auto family = home_system().base_metrics().mailbox_overflows;
+    auto label = overflow_policy_label(overflow_policy_);
+    mailbox_overflows_ = family->get_or_add({{"policy", label}});
+    if (overflow_policy_ == mailbox_overflow_policy::block)
+      blocked_senders_ = std::make_unique<blocked_senders>();
+  }
 }
 
 local_actor::~local_actor() {
@@ -157,8 +193,113 @@ void local_actor::initialize() {
   CAF_LOG_TRACE(CAF_ARG2("id", id()) << CAF_ARG2("name", name()));
 }
 
+bool local_actor::reserve_mailbox_slot(const mailbox_element& x,
+                                       execution_unit* ctx) {
+  CAF_ASSERT(is_bounded(x));
+  auto try_reserve = [this] {
+    auto n = bounded_messages_.load(std::memory_order_relaxed);
+    do {
+      if (n >= mailbox_capacity_)
+        return false;
+    } while (!bounded_messages_.compare_exchange_weak(
+      n, n + 1, std::memory_order_relaxed));
+    return true;
+  };
+  if (try_reserve())
+    return true;
+  // Blocking a sender that runs on a scheduler worker would stall all actors
+  // of that worker. Hence, only blocking actors and non-actor threads wait.
+  auto may_block = [&] {
+    if (auto src = actor_cast<abstract_actor*>(x.sender))
+      return src != this && src->getf(is_blocking_flag);
+    return ctx == nullptr;
+  };
+  switch (overflow_policy_) {
+    case mailbox_overflow_policy::drop_oldest:
+      // The actor discards its oldest message once it runs again.
+      bounded_messages_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    case mailbox_overflow_policy::block:
+      count_overflow();
+      if (may_block()) {
+        auto& st = *blocked_senders_;
+        std::unique_lock<std::mutex> guard{st.mtx};
+        st.cv.wait(guard, [&] { return st.closed || try_reserve(); });
+        // Let the mailbox bounce the message after the actor terminated.
+        if (st.closed)
+          bounded_messages_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      break;
+    case mailbox_overflow_policy::reject:
+      count_overflow();
+      break;
+    default:
+      CAF_LOG_DEBUG("mailbox full, drop newest message:" << CAF_ARG(x.mid));
+      count_overflow();
+      return false;
+  }
+  CAF_LOG_DEBUG("mailbox full, reject message:" << CAF_ARG(x.mid));
+  if (x.sender && x.mid.is_request())
+    x.sender->enqueue(nullptr, x.mid.response_id(),
+                      make_message(make_error(sec::mailbox_full)), ctx);
+  return false;
+}
+
+void local_actor::release_mailbox_slot() {
+  auto prev = bounded_messages_.fetch_sub(1, std::memory_order_relaxed);
+  CAF_ASSERT(prev > 0);
+  if (blocked_senders_ != nullptr && prev == mailbox_capacity_) {
+    std::unique_lock<std::mutex> guard{blocked_senders_->mtx};
+    blocked_senders_->cv.notify_all();
+  }
+}
+
+bool local_actor::discard_oldest() {
+  if (overflow_policy_ != mailbox_overflow_policy::drop_oldest)
+    return false;
+  auto n = bounded_messages_.load(std::memory_order_relaxed);
+  do {
+    if (n <= mailbox_capacity_)
+      return false;
+  } while (!bounded_messages_.compare_exchange_weak(
+    n, n - 1, std::memory_order_relaxed));
+  CAF_LOG_DEBUG("mailbox full, drop oldest message");
+  count_overflow();
+  return true;
+}
+
+bool local_actor::counts_against_capacity(const mailbox_element& x) noexcept {
+  if (!x.mid.is_normal_message() || x.mid.is_response())
+    return false;
+  auto& content = x.content();
+  if (content.size() != 1)
+    return true;
+  switch (content.type_at(0)) {
+    case type_id_v<exit_msg>:
+    case type_id_v<down_msg>:
+    case type_id_v<node_down_msg>:
+    case type_id_v<timeout_msg>:
+    case type_id_v<open_stream_msg>:
+      return false;
+    default:
+      return true;
+  }
+}
+
+void local_actor::count_overflow() {
+  if (mailbox_overflows_ != nullptr)
+    mailbox_overflows_->inc();
+}
+
 bool local_actor::cleanup(error&& fail_state, execution_unit* host) {
   CAF_LOG_TRACE(CAF_ARG(fail_state));
+  // Wake up all senders that wait for room in the mailbox.
+  if (blocked_senders_ != nullptr) {
+    std::unique_lock<std::mutex> guard{blocked_senders_->mtx};
+    blocked_senders_->closed = true;
+    blocked_senders_->cv.notify_all();
+  }
   // tell registry we're done
   unregister_from_system();
   CAF_LOG_TERMINATE_EVENT(this, fail_state);
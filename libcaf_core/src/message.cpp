@@ -76,7 +76,7 @@ bool load_data(Deserializer& source, message::data_ptr& data) {
         STOP(sec::unknown_type);
     }
     intrusive_ptr<detail::message_data> ptr;
-    if (auto vptr = malloc(sizeof(detail::message_data) + data_size)) {
+    if (auto vptr = detail::message_data::allocate(data_size)) {
       // We don't need to worry about exceptions here: the message_data
       // constructor as well as `move_to_list` are `noexcept`.
       ptr.reset(new (vptr) detail::message_data(ids.move_to_list()), false);
@@ -172,7 +172,7 @@ bool load_data(Deserializer& source, message::data_ptr& data) {
     GUARDED(source.end_sequence());
     // Merge elements into a single message data object.
     intrusive_ptr<detail::message_data> ptr;
-    if (auto vptr = malloc(sizeof(detail::message_data) + data_size)) {
+    if (auto vptr = detail::message_data::allocate(data_size)) {
       // We don't need to worry about exceptions here: the message_data
       // constructor as well as `move_to_list` are `noexcept`.
       ptr.reset(new (vptr) detail::message_data(ids.move_to_list()), false);
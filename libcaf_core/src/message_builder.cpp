@@ -23,7 +23,7 @@ message to_message_impl(size_t storage_size, TypeListBuilder& types,
                         ElementVector& elements) {
   if (storage_size == 0)
     return message{};
-  auto vptr = malloc(sizeof(message_data) + storage_size);
+  auto vptr = message_data::allocate(storage_size);
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   message_data* raw_ptr;
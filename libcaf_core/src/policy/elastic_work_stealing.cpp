@@ -0,0 +1,55 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/policy/elastic_work_stealing.hpp"
+
+#include <algorithm>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/config_value.hpp"
+#include "caf/defaults.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+namespace caf::policy {
+
+elastic_work_stealing::~elastic_work_stealing() {
+  // nop
+}
+
+elastic_work_stealing::elastic_state::elastic_state(
+  scheduler::abstract_coordinator* p)
+  : last_activation(0) {
+  namespace ns = defaults::elastic_stealing;
+  auto& cfg = p->config();
+  max_workers = std::max(p->num_workers(), size_t{1});
+  min_workers = std::clamp(get_or(cfg, "caf.elastic-stealing.min-threads",
+                                  ns::min_threads),
+                           size_t{1}, max_workers);
+  grow_threshold = std::max(get_or(cfg, "caf.elastic-stealing.grow-threshold",
+                                   ns::grow_threshold),
+                            size_t{1});
+  grow_interval = get_or(cfg, "caf.elastic-stealing.grow-interval",
+                         ns::grow_interval);
+  idle_timeout = get_or(cfg, "caf.elastic-stealing.idle-timeout",
+                        ns::idle_timeout);
+  active_workers = min_workers;
+  active_workers_gauge = p->system().metrics().gauge_singleton(
+    "caf.scheduler", "active-workers",
+    "Number of workers that currently receive jobs.");
+  active_workers_gauge->value(static_cast<int64_t>(min_workers));
+}
+
+elastic_work_stealing::worker_data::worker_data(
+  scheduler::abstract_coordinator* p)
+  : worker_state(p), elastic(std::make_shared<elastic_state>(p)) {
+  // nop
+}
+
+elastic_work_stealing::worker_data::worker_data(const worker_data& other)
+  : worker_state(other), elastic(other.elastic) {
+  // nop
+}
+
+} // namespace caf::policy
@@ -0,0 +1,24 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/policy/normal_messages.hpp"
+
+#include "caf/scheduled_actor.hpp"
+
+namespace caf::policy {
+
+type_id_list
+normal_messages::stash_key(const mailbox_element& x) const noexcept {
+  return self != nullptr ? self->stash_key(x) : type_id_list{nullptr};
+}
+
+size_t normal_messages::stash_epoch() const noexcept {
+  return self != nullptr ? self->stash_epoch() : 0;
+}
+
+bool normal_messages::retry(type_id_list types) const noexcept {
+  return self == nullptr || self->may_accept(types);
+}
+
+} // namespace caf::policy
@@ -0,0 +1,87 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/policy/numa_work_stealing.hpp"
+
+#include <algorithm>
+
+#include "caf/actor_system_config.hpp"
+#include "caf/config_value.hpp"
+#include "caf/defaults.hpp"
+#include "caf/scheduled_actor.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+namespace caf::policy {
+
+numa_work_stealing::~numa_work_stealing() {
+  // nop
+}
+
+size_t numa_work_stealing::numa_node_of(resumable* job) noexcept {
+  switch (job->subtype()) {
+    case resumable::scheduled_actor:
+    case resumable::io_actor:
+      return static_cast<scheduled_actor*>(job)->numa_node();
+    default:
+      return actor_config::any_numa_node;
+  }
+}
+
+numa_work_stealing::layout_type::layout_type(
+  scheduler::abstract_coordinator* p) {
+  namespace ns = defaults::numa_stealing;
+  auto& cfg = p->config();
+  auto topology = detail::numa_topology::load();
+  auto cpus = topology.cpus();
+  auto cpu_list = get_or(cfg, "caf.numa-stealing.cpu-list", ns::cpu_list);
+  if (!cpu_list.empty()) {
+    auto parsed = detail::parse_cpu_list(cpu_list);
+    if (parsed && !parsed->empty())
+      cpus = std::move(*parsed);
+    else
+      CAF_LOG_WARNING("invalid CPU list, using all CPUs:" << cpu_list);
+  }
+  auto pin = get_or(cfg, "caf.numa-stealing.pin-workers", ns::pin_workers);
+  inter_node_steal_interval = std::max(
+    get_or(cfg, "caf.numa-stealing.inter-node-steal-interval",
+           ns::inter_node_steal_interval),
+    size_t{1});
+  auto num_workers = p->num_workers();
+  worker_node.reserve(num_workers);
+  worker_cpu.reserve(num_workers);
+  for (size_t id = 0; id < num_workers; ++id) {
+    // Assign CPUs round-robin if we have more workers than CPUs.
+    auto cpu = cpus[id % cpus.size()];
+    auto node_id = topology.node_of(cpu).value_or(topology.nodes().front().id);
+    auto index = index_of(node_id);
+    if (index == node_ids.size()) {
+      node_ids.emplace_back(node_id);
+      node_workers.emplace_back();
+    }
+    node_workers[index].emplace_back(id);
+    worker_node.emplace_back(index);
+    worker_cpu.emplace_back(pin ? cpu : -1);
+  }
+  next_worker = std::make_unique<std::atomic<size_t>[]>(node_ids.size());
+}
+
+size_t numa_work_stealing::layout_type::index_of(size_t id) const noexcept {
+  auto i = std::find(node_ids.begin(), node_ids.end(), id);
+  return static_cast<size_t>(std::distance(node_ids.begin(), i));
+}
+
+numa_work_stealing::worker_data::worker_data(
+  scheduler::abstract_coordinator* p)
+  : worker_state(p),
+    layout(std::make_shared<layout_type>(p)),
+    steal_rounds(0) {
+  // nop
+}
+
+numa_work_stealing::worker_data::worker_data(const worker_data& other)
+  : worker_state(other), layout(other.layout), steal_rounds(0) {
+  // nop
+}
+
+} // namespace caf::policy
@@ -4,13 +4,17 @@
 
 #include "caf/policy/work_stealing.hpp"
 
+#include <algorithm>
+#include <string>
+
 #include "caf/actor_system_config.hpp"
 #include "caf/config_value.hpp"
 #include "caf/defaults.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
 #define CONFIG(str_name, var_name)                                             \
-  get_or(p->config(), "work-stealing." str_name,                               \
+  get_or(p->config(), "caf.work-stealing." str_name,                           \
          defaults::work_stealing::var_name)
 
 namespace caf::policy {
@@ -19,7 +23,7 @@ work_stealing::~work_stealing() {
   // nop
 }
 
-work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
+work_stealing::worker_state::worker_state(scheduler::abstract_coordinator* p)
   : rengine(std::random_device{}()),
     // no need to worry about wrap-around; if `p->num_workers() < 2`,
     // `uniform` will not be used anyway
@@ -30,17 +34,48 @@ work_stealing::worker_data::worker_data(scheduler::abstract_coordinator* p)
         timespan{0}},
        {CONFIG("moderate-poll-attempts", moderate_poll_attempts), 1,
         CONFIG("moderate-steal-interval", moderate_steal_interval),
-        CONFIG("moderate-sleep-duration", moderate_sleep_duration)},
+        timespan{0}},
        {1, 0, CONFIG("relaxed-steal-interval", relaxed_steal_interval),
-        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}} {
-  // nop
+        CONFIG("relaxed-sleep-duration", relaxed_sleep_duration)}}},
+    spinning_time(p->system().metrics().counter_singleton<double>(
+      "caf.scheduler", "spinning-time",
+      "Time idle workers spent polling for new jobs.", "seconds", true)),
+    parked_time(p->system().metrics().counter_singleton<double>(
+      "caf.scheduler", "parked-time",
+      "Time idle workers spent blocked while waiting for new jobs.", "seconds",
+      true)),
+    max_steal_batch(
+      std::max(CONFIG("max-steal-batch", max_steal_batch), size_t{1})),
+    run_next_limit(CONFIG("run-next-limit", run_next_limit)),
+    max_urgent_streak(CONFIG("max-urgent-streak", max_urgent_streak)) {
+  steal_buffer.reserve(max_steal_batch);
 }
 
-work_stealing::worker_data::worker_data(const worker_data& other)
+work_stealing::worker_state::worker_state(const worker_state& other)
   : rengine(std::random_device{}()),
     uniform(other.uniform),
-    strategies(other.strategies) {
-  // nop
+    strategies(other.strategies),
+    spinning_time(other.spinning_time),
+    parked_time(other.parked_time),
+    max_steal_batch(other.max_steal_batch),
+    run_next_limit(other.run_next_limit),
+    max_urgent_streak(other.max_urgent_streak) {
+  steal_buffer.reserve(max_steal_batch);
+}
+
+void work_stealing::init_steal_metrics(telemetry::metric_registry& reg,
+                                       size_t id, worker_state& data) {
+  auto id_str = std::to_string(id);
+  auto fetch = [&](string_view name, string_view helptext) {
+    auto fam = reg.counter_family("caf.scheduler", name, {"worker"}, helptext,
+                                  "1", true);
+    return fam->get_or_add({{"worker", id_str}});
+  };
+  data.steal_attempts = fetch("steal-attempts",
+                              "Number of attempts to steal jobs.");
+  data.successful_steals = fetch("successful-steals",
+                                 "Number of steal attempts that got a job.");
+  data.stolen_jobs = fetch("stolen-jobs", "Number of stolen jobs.");
 }
 
 } // namespace caf::policy
@@ -16,4 +16,8 @@ resumable::subtype_t resumable::subtype() const {
   return unspecified;
 }
 
+message_priority resumable::priority() const noexcept {
+  return message_priority::normal;
+}
+
 } // namespace caf
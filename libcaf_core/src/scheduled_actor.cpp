@@ -14,6 +14,8 @@
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/inbound_path.hpp"
 #include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/int_gauge.hpp"
 
 using namespace std::string_literals;
 
@@ -58,6 +60,28 @@ skippable_result drop_after_quit(scheduled_actor* self, message&) {
   return make_message();
 }
 
+// Checks whether `f` skips all messages regardless of the state of the actor.
+bool is_skip_handler(const scheduled_actor::default_handler& f) {
+  using fun_ptr = skippable_result (*)(scheduled_actor*, message&);
+  static const skip_t::fun skip_fun = skip;
+  auto ptr = f.target<fun_ptr>();
+  return ptr != nullptr && *ptr == *skip_fun.target<fun_ptr>();
+}
+
+// Returns `true` for every `n`-th call on the current thread. Counting per
+// thread instead of per actor avoids synchronizing concurrent senders.
+bool sample_enqueue_time(size_t n) noexcept {
+  if (n <= 1)
+    return true;
+  thread_local size_t countdown = 0;
+  if (countdown == 0) {
+    countdown = n - 1;
+    return true;
+  }
+  --countdown;
+  return false;
+}
+
 } // namespace
 
 // -- static helper functions --------------------------------------------------
@@ -110,22 +134,30 @@ error scheduled_actor::default_exception_handler(local_actor* ptr,
 
 scheduled_actor::scheduled_actor(actor_config& cfg)
   : super(cfg),
-    mailbox_(unit, unit, unit, unit, unit),
+    mailbox_(unit, unit, unit, unit, unit, unit),
     timeout_id_(0),
     default_handler_(print_and_drop),
     error_handler_(default_error_handler),
     down_handler_(default_down_handler),
     node_down_handler_(default_node_down_handler),
     exit_handler_(default_exit_handler),
-    private_thread_(nullptr)
+    private_thread_(nullptr),
+    numa_node_(cfg.numa_node),
+    max_time_slice_(cfg.max_time_slice),
+    scheduler_domain_(cfg.scheduler_domain)
 #ifdef CAF_ENABLE_EXCEPTIONS
     ,
     exception_handler_(default_exception_handler)
 #endif // CAF_ENABLE_EXCEPTIONS
 {
+  get_normal_queue().policy().self = this;
   auto& sys_cfg = home_system().config();
   max_batch_delay_ = get_or(sys_cfg, "caf.stream.max_batch_delay",
                             defaults::stream::max_batch_delay);
+  if (max_time_slice_.count() <= 0)
+    max_time_slice_ = scheduler_domain_ != nullptr
+                        ? scheduler_domain_->max_time_slice()
+                        : home_system().scheduler().max_time_slice();
 }
 
 scheduled_actor::~scheduled_actor() {
@@ -141,21 +173,26 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto sender = ptr->sender;
+  auto bounded = is_bounded(*ptr);
+  if (bounded && !reserve_mailbox_slot(*ptr, eu))
+    return;
   auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
   if (collects_metrics) {
-    ptr->set_enqueue_time();
+    if (sample_enqueue_time(home_system().metrics_actors_sample_rate()))
+      ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
   }
   switch (mailbox().push_back(std::move(ptr))) {
     case intrusive::inbox_result::unblocked_reader: {
       CAF_LOG_ACCEPT_EVENT(true);
       intrusive_ptr_add_ref(ctrl());
-      if (private_thread_)
+      if (private_thread_) {
         private_thread_->resume(this);
-      else if (eu != nullptr)
-        eu->exec_later(this);
-      else
-        home_system().scheduler().enqueue(this);
+      } else {
+        priority_ = mid.is_urgent_message() ? message_priority::high
+                                            : message_priority::normal;
+        schedule(eu);
+      }
       break;
     }
     case intrusive::inbox_result::queue_closed: {
@@ -163,6 +200,8 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       home_system().base_metrics().rejected_messages->inc();
       if (collects_metrics)
         metrics_.mailbox_size->dec();
+      if (bounded)
+        release_mailbox_slot();
       if (mid.is_request()) {
         detail::sync_request_bouncer f{exit_reason()};
         f(sender, mid);
@@ -175,6 +214,73 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       break;
   }
 }
+
+void scheduled_actor::enqueue_batch(mailbox_batch what, execution_unit* eu) {
+  CAF_ASSERT(!getf(is_blocking_flag));
+  CAF_LOG_TRACE(CAF_ARG2("size", what.size()));
+  if (what.empty())
+    return;
+  // Blocked senders wait for the actor to consume messages, which it cannot
+  // do before we have enqueued the batch.
+  if (mailbox_capacity() > 0
+      && overflow_policy() == mailbox_overflow_policy::block) {
+    abstract_actor::enqueue_batch(std::move(what), eu);
+    return;
+  }
+  // Apply the overflow policy and update metrics for each element first.
+  auto collects_metrics = getf(abstract_actor::collects_metrics_flag);
+  auto sample_rate = home_system().metrics_actors_sample_rate();
+  auto urgent = false;
+  mailbox_batch accepted;
+  while (auto ptr = what.pop_front()) {
+    CAF_LOG_SEND_EVENT(ptr);
+    if (is_bounded(*ptr) && !reserve_mailbox_slot(*ptr, eu))
+      continue;
+    if (collects_metrics) {
+      if (sample_enqueue_time(sample_rate))
+        ptr->set_enqueue_time();
+      metrics_.mailbox_size->inc();
+    }
+    urgent = urgent || ptr->mid.is_urgent_message();
+    accepted.push_back(std::move(ptr));
+  }
+  if (accepted.empty())
+    return;
+  switch (mailbox().push_back_chain(accepted.front(), accepted.back())) {
+    case intrusive::inbox_result::unblocked_reader: {
+      CAF_LOG_ACCEPT_EVENT(true);
+      accepted.release();
+      intrusive_ptr_add_ref(ctrl());
+      if (private_thread_) {
+        private_thread_->resume(this);
+      } else {
+        priority_ = urgent ? message_priority::high : message_priority::normal;
+        schedule(eu);
+      }
+      break;
+    }
+    case intrusive::inbox_result::queue_closed: {
+      CAF_LOG_REJECT_EVENT();
+      auto n = static_cast<int64_t>(accepted.size());
+      home_system().base_metrics().rejected_messages->inc(n);
+      if (collects_metrics)
+        metrics_.mailbox_size->dec(n);
+      detail::sync_request_bouncer f{exit_reason()};
+      while (auto ptr = accepted.pop_front()) {
+        if (is_bounded(*ptr))
+          release_mailbox_slot();
+        if (ptr->mid.is_request())
+          f(ptr->sender, ptr->mid);
+      }
+      break;
+    }
+    case intrusive::inbox_result::success:
+      CAF_LOG_ACCEPT_EVENT(false);
+      accepted.release();
+      break;
+  }
+}
+
 mailbox_element* scheduled_actor::peek_at_next_mailbox_element() {
   return mailbox().closed() || mailbox().blocked() ? nullptr : mailbox().peek();
 }
@@ -192,6 +298,8 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
   CAF_ASSERT(!getf(is_blocking_flag));
   if (!hide)
     register_at_system();
+  if (scheduler_domain_ != nullptr)
+    scheduler_domain_->domain_running_actors()->inc();
   auto delay_first_scheduling = lazy && mailbox().try_block();
   if (getf(is_detached_flag)) {
     private_thread_ = ctx->system().acquire_private_thread();
@@ -201,7 +309,7 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
     }
   } else if (!delay_first_scheduling) {
     intrusive_ptr_add_ref(ctrl());
-    ctx->exec_later(this);
+    schedule(ctx);
   }
 }
 
@@ -210,6 +318,8 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   // Shutdown hosting thread when running detached.
   if (private_thread_)
     home_system().release_private_thread(private_thread_);
+  if (scheduler_domain_ != nullptr)
+    scheduler_domain_->domain_running_actors()->dec();
   // Clear state for open requests.
   awaited_responses_.clear();
   multiplexed_responses_.clear();
@@ -226,6 +336,8 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
     mailbox_.close();
     get_normal_queue().flush_cache();
     get_urgent_queue().flush_cache();
+    get_conflating_queue().flush_cache();
+    drop_superseded_messages();
     detail::sync_request_bouncer bounce{fail_state};
     auto dropped = mailbox_.queue().new_round(1000, bounce).consumed_items;
     while (dropped > 0) {
@@ -246,6 +358,10 @@ resumable::subtype_t scheduled_actor::subtype() const {
   return resumable::scheduled_actor;
 }
 
+message_priority scheduled_actor::priority() const noexcept {
+  return priority_;
+}
+
 void scheduled_actor::intrusive_ptr_add_ref_impl() {
   intrusive_ptr_add_ref(ctrl());
 }
@@ -261,6 +377,24 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
   if (!activate(ctx))
     return resumable::done;
   size_t consumed = 0;
+  // Stop after consuming `max_throughput` messages or once the time slice is
+  // used up. Reading the steady clock is cheap compared to dispatching a
+  // message, so we check it after each message.
+  using clock_type = std::chrono::steady_clock;
+  auto timed = !is_infinite(max_time_slice_);
+  auto deadline = timed ? clock_type::now() + max_time_slice_
+                        : clock_type::time_point{};
+  auto out_of_time = false;
+  auto consume = [&] {
+    if (++consumed >= max_throughput)
+      return false;
+    if (timed && clock_type::now() >= deadline) {
+      out_of_time = true;
+      return false;
+    }
+    return true;
+  };
+  auto exhausted = [&] { return consumed >= max_throughput || out_of_time; };
   actor_clock::time_point tout{actor_clock::duration_type{0}};
   auto reset_timeouts_if_needed = [&] {
     // Set a new receive timeout if we called our behavior at least once.
@@ -275,24 +409,33 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     }
   };
   // Callback for handling urgent and normal messages.
-  auto handle_async = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_async = [this, &consume](mailbox_element& x) {
+    auto bounded = is_bounded(x);
+    if (bounded && discard_oldest()) {
+      if (metrics_.mailbox_size)
+        metrics_.mailbox_size->dec();
+      return intrusive::task_result::resume;
+    }
+    auto result = run_with_metrics(x, [this, &consume, &x] {
       switch (reactivate(x)) {
         case activation_result::terminated:
           return intrusive::task_result::stop;
         case activation_result::success:
-          return ++consumed < max_throughput ? intrusive::task_result::resume
-                                             : intrusive::task_result::stop_all;
+          return consume() ? intrusive::task_result::resume
+                           : intrusive::task_result::stop_all;
         case activation_result::skipped:
           return intrusive::task_result::skip;
         default:
           return intrusive::task_result::resume;
       }
     });
+    if (bounded && result != intrusive::task_result::skip)
+      release_mailbox_slot();
+    return result;
   };
   // Callback for handling upstream messages (e.g., ACKs).
-  auto handle_umsg = [this, max_throughput, &consumed](mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &x] {
+  auto handle_umsg = [this, &consume](mailbox_element& x) {
+    return run_with_metrics(x, [this, &consume, &x] {
       current_mailbox_element(&x);
       CAF_LOG_RECEIVE_EVENT((&x));
       CAF_BEFORE_PROCESSING(this, x);
@@ -303,14 +446,14 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       };
       visit(f, um.content);
       CAF_AFTER_PROCESSING(this, invoke_message_result::consumed);
-      return ++consumed < max_throughput ? intrusive::task_result::resume
-                                         : intrusive::task_result::stop_all;
+      return consume() ? intrusive::task_result::resume
+                       : intrusive::task_result::stop_all;
     });
   };
   // Callback for handling downstream messages (e.g., batches).
-  auto handle_dmsg = [this, &consumed, max_throughput](stream_slot, auto& q,
-                                                       mailbox_element& x) {
-    return run_with_metrics(x, [this, max_throughput, &consumed, &q, &x] {
+  auto handle_dmsg = [this, &consume](stream_slot, auto& q,
+                                      mailbox_element& x) {
+    return run_with_metrics(x, [this, &consume, &q, &x] {
       current_mailbox_element(&x);
       CAF_LOG_RECEIVE_EVENT((&x));
       CAF_BEFORE_PROCESSING(this, x);
@@ -360,21 +503,28 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       };
       auto res = visit(f, dm.content);
       CAF_AFTER_PROCESSING(this, invoke_message_result::consumed);
-      return ++consumed < max_throughput ? res
-                                         : intrusive::task_result::stop_all;
+      return consume() ? res : intrusive::task_result::stop_all;
     });
   };
   std::vector<stream_manager*> managers;
   mailbox_element_ptr ptr;
-  while (consumed < max_throughput) {
+  while (!exhausted()) {
     CAF_LOG_DEBUG("start new DRR round");
     mailbox_.fetch_more();
+    if (conflation_rules_)
+      drop_superseded_messages();
     auto prev = consumed; // Caches the value before processing more.
     // TODO: maybe replace '3' with configurable / adaptive value?
     static constexpr size_t quantum = 3;
     // Dispatch urgent and normal (asynchronous) messages.
     get_urgent_queue().new_round(quantum * 3, handle_async);
     get_normal_queue().new_round(quantum, handle_async);
+    if (metrics_.stash_size) {
+      auto& q = get_normal_queue();
+      metrics_.stash_size->value(static_cast<int64_t>(q.stashed()));
+      metrics_.stash_retries->inc(static_cast<int64_t>(q.take_retried()));
+    }
+    get_conflating_queue().new_round(quantum, handle_async);
     // Consume all upstream messages. They are lightweight by design and ACKs
     // come with new credit, allowing us to advance stream traffic.
     if (auto tts = get_upstream_queue().total_task_size(); tts > 0) {
@@ -398,7 +548,7 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
         for (auto mgr : managers)
           mgr->push();
       } while (
-        consumed < max_throughput
+        !exhausted()
         && get_downstream_queue().new_round(0, handle_dmsg).consumed_items > 0);
     }
     // Update metrics or try returning if the actor consumed nothing.
@@ -407,6 +557,7 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     if (delta > 0) {
       auto signed_val = static_cast<int64_t>(delta);
       home_system().base_metrics().processed_messages->inc(signed_val);
+      ctx->count_processed_messages(delta);
     } else {
       reset_timeouts_if_needed();
       if (mailbox().try_block())
@@ -423,11 +574,14 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
     if (auto now = clock().now(); now >= tout)
       tout = advance_streams(now);
   }
-  CAF_LOG_DEBUG("max throughput reached");
+  CAF_LOG_DEBUG("max throughput reached or time slice used up");
   reset_timeouts_if_needed();
   if (mailbox().try_block())
     return resumable::awaiting_message;
   // time's up
+  priority_ = get_urgent_queue().total_task_size() > 0
+                ? message_priority::high
+                : message_priority::normal;
   return resumable::resume_later;
 }
 
@@ -437,6 +591,36 @@ proxy_registry* scheduled_actor::proxy_registry_ptr() {
   return nullptr;
 }
 
+void scheduled_actor::schedule(execution_unit* ctx) {
+  // Never run actors on a worker of another scheduler domain.
+  if (ctx != nullptr && ctx->scheduler_domain() == scheduler_domain_)
+    ctx->exec_later(this);
+  else if (scheduler_domain_ != nullptr)
+    scheduler_domain_->enqueue(this);
+  else
+    home_system().scheduler().enqueue(this);
+}
+
+type_id_list
+scheduled_actor::stash_key(const mailbox_element& x) const noexcept {
+  return indexable_skip_ == &x ? x.content().types() : type_id_list{nullptr};
+}
+
+bool scheduled_actor::may_accept(type_id_list types) const noexcept {
+  if (!is_skip_handler(default_handler_))
+    return true;
+  return !bhvr_stack_.empty() && bhvr_stack_.back().accepts(types);
+}
+
+detail::conflation_rules& scheduled_actor::enable_conflation() {
+  if (!conflation_rules_) {
+    conflation_rules_.reset(new detail::conflation_rules);
+    mailbox_.queue().policy().conflation = conflation_rules_.get();
+    get_conflating_queue().policy().rules = conflation_rules_.get();
+  }
+  return *conflation_rules_;
+}
+
 // -- state modifiers ----------------------------------------------------------
 
 void scheduled_actor::quit(error x) {
@@ -678,6 +862,7 @@ scheduled_actor::categorize(mailbox_element& x) {
 invoke_message_result scheduled_actor::consume(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
   current_element_ = &x;
+  indexable_skip_ = nullptr;
   CAF_LOG_RECEIVE_EVENT(current_element_);
   CAF_BEFORE_PROCESSING(this, x);
   // Wrap the actual body for the function.
@@ -749,6 +934,10 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
           [&](skip_t&) {
             if (had_timeout)
               setf(has_timeout_flag);
+            // No handler of the current behavior accepts the types of `x`.
+            // Hence, we only need to retry `x` after changing the behavior.
+            if (is_skip_handler(default_handler_))
+              indexable_skip_ = &x;
             return invoke_message_result::skipped;
           });
         return visit(f, sres);
@@ -911,10 +1100,19 @@ void scheduled_actor::push_to_cache(mailbox_element_ptr ptr) {
     q.inc_total_task_size(q.policy().task_size(*ptr));
     q.cache().push_back(ptr.release());
   };
-  if (p.id_of(*ptr) == normal_queue_index)
-    push(std::get<normal_queue_index>(qs));
-  else
-    push(std::get<urgent_queue_index>(qs));
+  switch (p.id_of(*ptr)) {
+    case normal_queue_index: {
+      auto& q = std::get<normal_queue_index>(qs);
+      q.inc_total_task_size(q.policy().task_size(*ptr));
+      q.stash(std::move(ptr));
+      break;
+    }
+    case conflating_queue_index:
+      push(std::get<conflating_queue_index>(qs));
+      break;
+    default:
+      push(std::get<urgent_queue_index>(qs));
+  }
 }
 
 scheduled_actor::urgent_queue& scheduled_actor::get_urgent_queue() {
@@ -933,6 +1131,19 @@ scheduled_actor::downstream_queue& scheduled_actor::get_downstream_queue() {
   return get<downstream_queue_index>(mailbox_.queue().queues());
 }
 
+scheduled_actor::conflating_queue& scheduled_actor::get_conflating_queue() {
+  return get<conflating_queue_index>(mailbox_.queue().queues());
+}
+
+void scheduled_actor::drop_superseded_messages() {
+  get_conflating_queue().drop_superseded([this](mailbox_element& x) {
+    if (metrics_.mailbox_size)
+      metrics_.mailbox_size->dec();
+    if (is_bounded(x))
+      release_mailbox_slot();
+  });
+}
+
 bool scheduled_actor::add_inbound_path(type_id_t,
                                        std::unique_ptr<inbound_path> path) {
   static constexpr size_t queue_index = downstream_queue_index;
@@ -25,9 +25,11 @@
 #include "caf/policy/work_stealing.hpp"
 #include "caf/scheduled_actor.hpp"
 #include "caf/scheduler/coordinator.hpp"
+#include "caf/scheduler/sampling_profiler.hpp"
 #include "caf/scoped_actor.hpp"
 #include "caf/send.hpp"
 #include "caf/system_messages.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
 namespace caf::scheduler {
 
@@ -178,6 +180,9 @@ bool abstract_coordinator::detaches_utility_actors() const {
 
 void abstract_coordinator::start() {
   CAF_LOG_TRACE("");
+  // Scheduler domains share the utility actors of the default scheduler.
+  if (is_scheduler_domain())
+    return;
   // launch utility actors
   static constexpr auto fs = hidden + detached;
   utility_actors_[printer_id] = system_.spawn<printer_actor, fs>();
@@ -187,10 +192,72 @@ void abstract_coordinator::init(actor_system_config& cfg) {
   namespace sr = defaults::scheduler;
   max_throughput_ = get_or(cfg, "caf.scheduler.max-throughput",
                            sr::max_throughput);
+  // A config value of 0 disables time slices.
+  auto slice = get_or(cfg, "caf.scheduler.max-time-slice", sr::max_time_slice);
+  max_time_slice_ = slice.count() > 0 ? slice : infinite;
   num_workers_ = get_or(cfg, "caf.scheduler.max-threads",
                         default_thread_count());
 }
 
+void abstract_coordinator::init_domain(std::string name,
+                                       actor_system_config& cfg) {
+  CAF_ASSERT(!name.empty());
+  init(cfg);
+  domain_name_ = std::move(name);
+  auto prefix = "caf.scheduler.domains." + domain_name_ + '.';
+  max_throughput_ = get_or(cfg, prefix + "max-throughput", max_throughput_);
+  if (auto slice = get_as<timespan>(cfg, prefix + "max-time-slice"))
+    max_time_slice_ = slice->count() > 0 ? *slice : infinite;
+  num_workers_ = std::max(get_or(cfg, prefix + "max-threads", num_workers_),
+                          size_t{1});
+  auto& reg = system_.metrics();
+  auto workers = reg.gauge_family("caf.scheduler", "domain-workers",
+                                  {"domain"},
+                                  "Number of workers in a scheduler domain.");
+  workers->get_or_add({{"domain", domain_name_}})
+    ->value(static_cast<int64_t>(num_workers_));
+  auto actors = reg.gauge_family("caf.scheduler", "domain-running-actors",
+                                 {"domain"},
+                                 "Number of running actors in a scheduler "
+                                 "domain.");
+  domain_running_actors_ = actors->get_or_add({{"domain", domain_name_}});
+}
+
+resumable* abstract_coordinator::steal_job() {
+  return nullptr;
+}
+
+void abstract_coordinator::steal_from(
+  std::vector<abstract_coordinator*> sources) {
+  auto fam = system_.metrics().counter_family(
+    "caf.scheduler", "domain-stolen-jobs", {"domain"},
+    "Number of jobs of a scheduler domain that ran in another domain.", "1",
+    true);
+  for (auto src : sources) {
+    if (src->domain_stolen_jobs_ == nullptr) {
+      auto name = src->is_scheduler_domain() ? src->domain_name_ : "default";
+      src->domain_stolen_jobs_ = fam->get_or_add({{"domain", name}});
+    }
+  }
+  steal_sources_ = std::move(sources);
+}
+
+resumable* abstract_coordinator::steal_from_other_domains_impl() {
+  for (auto src : steal_sources_) {
+    if (auto job = src->steal_job()) {
+      // Only actors may migrate. Other jobs such as the shutdown helpers of a
+      // coordinator must run on a worker of their own domain.
+      if (job->subtype() != resumable::scheduled_actor) {
+        src->enqueue(job);
+        continue;
+      }
+      src->domain_stolen_jobs_->inc();
+      return job;
+    }
+  }
+  return nullptr;
+}
+
 actor_system::module::id_t abstract_coordinator::id() const {
   return module::scheduler;
 }
@@ -201,6 +268,8 @@ void* abstract_coordinator::subtype_ptr() {
 
 void abstract_coordinator::stop_actors() {
   CAF_LOG_TRACE("");
+  if (is_scheduler_domain())
+    return;
   scoped_actor self{system_, true};
   for (auto& x : utility_actors_)
     anon_send_exit(x, exit_reason::user_shutdown);
@@ -208,10 +277,57 @@ void abstract_coordinator::stop_actors() {
 }
 
 abstract_coordinator::abstract_coordinator(actor_system& sys)
-  : next_worker_(0), max_throughput_(0), num_workers_(0), system_(sys) {
+  : next_worker_(0),
+    max_throughput_(0),
+    max_time_slice_(infinite),
+    num_workers_(0),
+    system_(sys) {
+  // nop
+}
+
+abstract_coordinator::~abstract_coordinator() {
   // nop
 }
 
+void abstract_coordinator::start_profiler() {
+  namespace sr = defaults::scheduler;
+  auto& cfg = config();
+  if (!get_or(cfg, "caf.scheduler.enable-profiling", false))
+    return;
+  auto file_name = get_or(cfg, "caf.scheduler.profiling-output-file",
+                          sr::profiling_output_file);
+  if (file_name.empty()) {
+    std::cerr << "[WARNING] caf.scheduler.enable-profiling is set without "
+                 "caf.scheduler.profiling-output-file (no profiler output "
+                 "will be generated)"
+              << std::endl;
+    return;
+  }
+  // Each domain writes to its own file.
+  if (is_scheduler_domain()) {
+    file_name += '.';
+    file_name += domain_name_;
+  }
+  auto sample_rate = get_or(cfg, "caf.scheduler.profiling-sample-rate",
+                            sr::profiling_sample_rate);
+  auto buffer_size = get_or(cfg, "caf.scheduler.profiling-buffer-size",
+                            sr::profiling_buffer_size);
+  auto resolution = get_or(cfg, "caf.scheduler.profiling-resolution",
+                           sr::profiling_resolution);
+  profiler_ = std::make_unique<sampling_profiler>(num_workers_, sample_rate,
+                                                  buffer_size);
+  if (!profiler_->start(file_name, resolution)) {
+    std::cerr << R"([WARNING] could not open file ")" << file_name
+              << R"(" (no profiler output will be generated))" << std::endl;
+    profiler_.reset();
+  }
+}
+
+void abstract_coordinator::stop_profiler() {
+  if (profiler_)
+    profiler_->stop();
+}
+
 void abstract_coordinator::cleanup_and_release(resumable* ptr) {
   class dummy_unit : public execution_unit {
   public:
@@ -0,0 +1,211 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/scheduler/sampling_profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/detail/print.hpp"
+#include "caf/error.hpp"
+#include "caf/execution_unit.hpp"
+#include "caf/scheduled_actor.hpp"
+#include "caf/sec.hpp"
+
+namespace caf::scheduler {
+
+namespace {
+
+// Identifies the binary output format of the profiler.
+constexpr string_view file_header = "CAFPROF1";
+
+template <class Inspector>
+bool inspect_sample(Inspector& f, sampling_profiler::sample& x,
+                    std::string& name) {
+  return f.value(x.worker) && f.value(x.messages) && f.value(x.id)
+         && f.value(x.start) && f.value(x.duration) && f.value(name);
+}
+
+} // namespace
+
+// -- ring buffer --------------------------------------------------------------
+
+sampling_profiler::ring_buffer::ring_buffer(size_t capacity)
+  : head_(0), tail_(0) {
+  size_t size = 1;
+  while (size < capacity)
+    size <<= 1;
+  buf_.reset(new sample[size]);
+  mask_ = size - 1;
+}
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+sampling_profiler::sampling_profiler(size_t num_workers, size_t sample_rate,
+                                     size_t buffer_size)
+  : sample_rate_(std::max(sample_rate, size_t{1})), dropped_(0) {
+  buffers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i)
+    buffers_.emplace_back(
+      std::make_unique<ring_buffer>(std::max(buffer_size, size_t{1})));
+}
+
+sampling_profiler::~sampling_profiler() {
+  stop();
+}
+
+// -- sampling -----------------------------------------------------------------
+
+resumable::resume_result sampling_profiler::resume(execution_unit* ctx,
+                                                   size_t id, resumable* job,
+                                                   size_t max_throughput) {
+  using clock_type = std::chrono::steady_clock;
+  sample x;
+  x.worker = static_cast<uint32_t>(id);
+  // The job may get destroyed or run on another worker after `resume`
+  // returns, so we must read its properties here.
+  if (job->subtype() == resumable::scheduled_actor) {
+    auto self = static_cast<scheduled_actor*>(job);
+    x.id = self->id();
+    strncpy(x.name, self->name(), max_name_length);
+    x.name[max_name_length] = '\0';
+  } else {
+    x.id = 0;
+    x.name[0] = '\0';
+  }
+  auto processed = ctx->processed_messages();
+  auto t0 = clock_type::now();
+  auto result = job->resume(ctx, max_throughput);
+  auto t1 = clock_type::now();
+  x.messages = static_cast<uint32_t>(ctx->processed_messages() - processed);
+  using std::chrono::duration_cast;
+  x.start = duration_cast<timespan>(t0.time_since_epoch()).count();
+  x.duration = duration_cast<timespan>(t1 - t0).count();
+  if (!buffers_[id]->push(x))
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  return result;
+}
+
+// -- output -------------------------------------------------------------------
+
+bool sampling_profiler::start(const std::string& file_name,
+                              timespan interval) {
+  file_.open(file_name, std::ios::binary);
+  if (!file_)
+    return false;
+  file_.write(file_header.data(),
+              static_cast<std::streamsize>(file_header.size()));
+  running_ = true;
+  flusher_ = std::thread{[this, interval] { run(interval); }};
+  return true;
+}
+
+void sampling_profiler::stop() {
+  if (!flusher_.joinable())
+    return;
+  {
+    std::unique_lock<std::mutex> guard{mtx_};
+    running_ = false;
+    cv_.notify_all();
+  }
+  flusher_.join();
+  if (auto n = dropped_samples(); n > 0)
+    std::cerr << "[WARNING] scheduler profiler dropped " << n
+              << " samples, consider a larger "
+                 "caf.scheduler.profiling-buffer-size"
+              << std::endl;
+}
+
+size_t sampling_profiler::flush(byte_buffer& buf) {
+  binary_serializer sink{nullptr, buf};
+  std::string name;
+  size_t result = 0;
+  for (auto& ptr : buffers_)
+    result += ptr->drain([&](sample& x) {
+      name = x.name;
+      inspect_sample(sink, x, name);
+    });
+  return result;
+}
+
+void sampling_profiler::run(timespan interval) {
+  byte_buffer buf;
+  auto write = [&] {
+    if (flush(buf) > 0) {
+      file_.write(reinterpret_cast<const char*>(buf.data()),
+                  static_cast<std::streamsize>(buf.size()));
+      file_.flush();
+      buf.clear();
+    }
+  };
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (running_) {
+    cv_.wait_for(guard, interval);
+    write();
+  }
+  // Pick up samples from the last jobs of the workers.
+  write();
+  file_.close();
+}
+
+error sampling_profiler::convert_to_trace_events(std::istream& in,
+                                                 std::ostream& out) {
+  byte_buffer input;
+  std::transform(std::istreambuf_iterator<char>{in},
+                 std::istreambuf_iterator<char>{}, std::back_inserter(input),
+                 [](char c) { return static_cast<byte>(c); });
+  if (input.size() < file_header.size()
+      || memcmp(input.data(), file_header.data(), file_header.size()) != 0)
+    return make_error(sec::invalid_argument,
+                      "input is not a scheduler profiler output");
+  binary_deserializer source{nullptr, input};
+  source.skip(file_header.size());
+  std::vector<std::pair<sample, std::string>> samples;
+  while (source.remaining() > 0) {
+    auto& [x, name] = samples.emplace_back();
+    if (!inspect_sample(source, x, name))
+      return source.get_error();
+  }
+  // Chrome expects timestamps in microseconds. We start at the earliest sample.
+  int64_t t0 = 0;
+  if (!samples.empty())
+    t0 = std::min_element(samples.begin(), samples.end(),
+                          [](const auto& x, const auto& y) {
+                            return x.first.start < y.first.start;
+                          })
+           ->first.start;
+  auto to_us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  std::string line;
+  out << "{\"traceEvents\":[";
+  for (auto& [x, name] : samples) {
+    line.clear();
+    line += &x == &samples.front().first ? "\n" : ",\n";
+    line += "{\"name\":";
+    detail::print_escaped(line, name.empty() ? "job" : name);
+    line += ",\"cat\":\"";
+    line += x.id != 0 ? "actor" : "job";
+    line += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+    line += std::to_string(x.worker);
+    line += ",\"ts\":";
+    line += std::to_string(to_us(x.start - t0));
+    line += ",\"dur\":";
+    line += std::to_string(to_us(x.duration));
+    line += ",\"args\":{\"id\":";
+    line += std::to_string(x.id);
+    line += ",\"messages\":";
+    line += std::to_string(x.messages);
+    line += "}}";
+    out << line;
+  }
+  out << "\n]}\n";
+  return none;
+}
+
+} // namespace caf::scheduler
@@ -4,6 +4,7 @@
 
 #include "caf/telemetry/collector/prometheus.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <type_traits>
@@ -179,6 +180,7 @@ string_view prometheus::collect_from(const metric_registry& registry,
   now_ = now;
   registry.collect(*this);
   current_family_ = nullptr;
+  append_hottest_mailboxes();
   return {buf_.data(), buf_.size()};
 }
 
@@ -212,6 +214,9 @@ void prometheus::operator()(const metric_family* family, const metric* instance,
   set_current_family(family, "gauge");
   append(buf_, family, instance, ' ', gauge->value(), ' ', ms_timestamp{now_},
          '\n');
+  if (hottest_mailboxes_ > 0 && family->prefix() == "caf.actor"
+      && family->name() == "mailbox-size")
+    mailbox_sizes_.emplace_back(gauge->value(), instance);
 }
 
 void prometheus::operator()(const metric_family* family, const metric* instance,
@@ -295,4 +300,25 @@ void prometheus::append_histogram(const metric_family* family,
   append(buf_, vm[index++], acc, ' ', ms_timestamp{now_}, '\n');
 }
 
+void prometheus::append_hottest_mailboxes() {
+  if (mailbox_sizes_.empty())
+    return;
+  auto k = std::min(hottest_mailboxes_, mailbox_sizes_.size());
+  auto first = mailbox_sizes_.begin();
+  auto cmp = [](const auto& x, const auto& y) { return x.first > y.first; };
+  std::partial_sort(first, first + k, mailbox_sizes_.end(), cmp);
+  append(buf_,
+         "# HELP caf_actor_hottest_mailboxes Actors with the most messages "
+         "in their mailbox.\n"
+         "# TYPE caf_actor_hottest_mailboxes gauge\n"_sv);
+  for (size_t rank = 0; rank < k; ++rank) {
+    auto [size, instance] = mailbox_sizes_[rank];
+    auto labels = instance->labels();
+    labels.emplace_back("rank", std::to_string(rank + 1));
+    append(buf_, "caf_actor_hottest_mailboxes"_sv, labels, ' ', size, ' ',
+           ms_timestamp{now_}, '\n');
+  }
+  mailbox_sizes_.clear();
+}
+
 } // namespace caf::telemetry::collector
@@ -9,6 +9,7 @@
 #include "core-test.hpp"
 
 #include <functional>
+#include <string>
 
 #include "caf/send.hpp"
 #include "caf/behavior.hpp"
@@ -90,6 +91,42 @@ CAF_TEST(multiple_lambda_construct) {
   CAF_CHECK_EQUAL(res_of(f, m3), none);
 }
 
+CAF_TEST(behaviors with many handlers dispatch via hash table) {
+  behavior f{
+    [](int8_t) { return 1; },
+    [](int16_t) { return 2; },
+    [](int64_t) { return 3; },
+    [](uint8_t) { return 4; },
+    [](uint16_t) { return 5; },
+    [](uint32_t) { return 6; },
+    [](uint64_t) { return 7; },
+    [](double) { return 8; },
+    [](const std::string&) { return 9; },
+    [](int x, int y, int z) { return x + y + z; },
+    [](int x) { return x + 10; },
+    [](int x) { return x + 20; },
+    [](int x, int y) { return x * y; },
+  };
+  auto msg = [](auto x) { return make_message(x); };
+  auto m_i8 = msg(int8_t{0});
+  auto m_u64 = msg(uint64_t{0});
+  auto m_dbl = msg(0.);
+  auto m_str = msg(std::string{"foo"});
+  auto m_flt = msg(0.f);
+  auto m_nil = message{};
+  CAF_CHECK_EQUAL(res_of(f, m_i8), 1);
+  CAF_CHECK_EQUAL(res_of(f, m_u64), 7);
+  CAF_CHECK_EQUAL(res_of(f, m_dbl), 8);
+  CAF_CHECK_EQUAL(res_of(f, m_str), 9);
+  CAF_MESSAGE("the first handler wins if several handlers match");
+  CAF_CHECK_EQUAL(res_of(f, m1), 11);
+  CAF_CHECK_EQUAL(res_of(f, m2), 2);
+  CAF_CHECK_EQUAL(res_of(f, m3), 6);
+  CAF_MESSAGE("messages without matching handler fall through");
+  CAF_CHECK_EQUAL(f(m_flt), none);
+  CAF_CHECK_EQUAL(f(m_nil), none);
+}
+
 CAF_TEST(become_empty_behavior) {
   actor_system_config cfg{};
   actor_system sys{cfg};
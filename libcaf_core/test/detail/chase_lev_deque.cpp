@@ -0,0 +1,126 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.chase_lev_deque
+
+#include "caf/detail/chase_lev_deque.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using int_deque = detail::chase_lev_deque<int>;
+
+struct fixture {
+  fixture() : xs(4), queue(8) {
+    std::iota(xs.begin(), xs.end(), 0);
+  }
+
+  std::vector<int> xs;
+
+  int_deque queue;
+
+  std::vector<int> values(size_t n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(chase_lev_deque_tests, fixture)
+
+CAF_TEST(a default constructed deque is empty) {
+  CAF_CHECK(queue.empty());
+  CAF_CHECK_EQUAL(queue.size(), 0u);
+  CAF_CHECK_EQUAL(queue.take_bottom(), nullptr);
+  CAF_CHECK_EQUAL(queue.take_top(), nullptr);
+}
+
+CAF_TEST(the owner takes elements in LIFO order) {
+  for (auto& x : xs)
+    queue.push_bottom(&x);
+  CAF_CHECK_EQUAL(queue.size(), 4u);
+  CAF_CHECK_EQUAL(queue.take_bottom(), &xs[3]);
+  CAF_CHECK_EQUAL(queue.take_bottom(), &xs[2]);
+  CAF_CHECK_EQUAL(queue.take_bottom(), &xs[1]);
+  CAF_CHECK_EQUAL(queue.take_bottom(), &xs[0]);
+  CAF_CHECK_EQUAL(queue.take_bottom(), nullptr);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(thieves take elements in FIFO order) {
+  for (auto& x : xs)
+    queue.push_bottom(&x);
+  CAF_CHECK_EQUAL(queue.take_top(), &xs[0]);
+  CAF_CHECK_EQUAL(queue.take_top(), &xs[1]);
+  CAF_CHECK_EQUAL(queue.take_bottom(), &xs[3]);
+  CAF_CHECK_EQUAL(queue.take_top(), &xs[2]);
+  CAF_CHECK_EQUAL(queue.take_top(), nullptr);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(the deque grows when running out of capacity) {
+  auto ys = values(100);
+  CAF_CHECK_EQUAL(queue.capacity(), 8u);
+  for (auto& y : ys)
+    queue.push_bottom(&y);
+  CAF_CHECK_EQUAL(queue.size(), 100u);
+  CAF_CHECK_EQUAL(queue.capacity(), 128u);
+  for (auto& y : ys)
+    CAF_CHECK_EQUAL(queue.take_top(), &y);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(concurrent thieves receive each element exactly once) {
+  static constexpr size_t num_thieves = 3;
+  static constexpr size_t num_values = 10'000;
+  auto ys = values(num_values);
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int*>> stolen(num_thieves);
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&, i] {
+      auto& out = stolen[i];
+      while (!done.load()) {
+        if (auto ptr = queue.take_top())
+          out.push_back(ptr);
+        else
+          std::this_thread::yield();
+      }
+      while (auto ptr = queue.take_top())
+        out.push_back(ptr);
+    });
+  std::vector<int*> owned;
+  for (size_t i = 0; i < num_values; ++i) {
+    queue.push_bottom(&ys[i]);
+    if (i % 3 == 0)
+      if (auto ptr = queue.take_bottom())
+        owned.push_back(ptr);
+  }
+  while (auto ptr = queue.take_bottom())
+    owned.push_back(ptr);
+  done = true;
+  for (auto& t : thieves)
+    t.join();
+  std::vector<int> result;
+  for (auto ptr : owned)
+    result.push_back(*ptr);
+  for (auto& vec : stolen)
+    for (auto ptr : vec)
+      result.push_back(*ptr);
+  std::sort(result.begin(), result.end());
+  CAF_CHECK_EQUAL(result, ys);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
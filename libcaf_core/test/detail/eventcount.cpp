@@ -0,0 +1,69 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.eventcount
+
+#include "caf/detail/eventcount.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct fixture {
+  detail::eventcount ec;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(eventcount_tests, fixture)
+
+CAF_TEST(notifying without waiters is a nop) {
+  CAF_CHECK_EQUAL(ec.num_waiters(), 0u);
+  ec.notify_one();
+  ec.notify_all();
+  auto key = ec.prepare_wait();
+  CAF_CHECK_EQUAL(ec.num_waiters(), 1u);
+  CAF_CHECK_EQUAL(ec.wait_for(key, 1ms), false);
+  CAF_CHECK_EQUAL(ec.num_waiters(), 0u);
+}
+
+CAF_TEST(cancel_wait withdraws the intent to wait) {
+  ec.prepare_wait();
+  CAF_CHECK_EQUAL(ec.num_waiters(), 1u);
+  ec.cancel_wait();
+  CAF_CHECK_EQUAL(ec.num_waiters(), 0u);
+}
+
+CAF_TEST(notifications after prepare_wait are never lost) {
+  auto key = ec.prepare_wait();
+  ec.notify_one();
+  CAF_CHECK_EQUAL(ec.wait_for(key, 10s), true);
+  CAF_CHECK_EQUAL(ec.num_waiters(), 0u);
+}
+
+CAF_TEST(notify_one wakes up a blocked thread) {
+  std::atomic<int> value{0};
+  std::thread consumer{[&] {
+    for (;;) {
+      auto key = ec.prepare_wait();
+      if (value.load() != 0) {
+        ec.cancel_wait();
+        return;
+      }
+      ec.wait(key);
+    }
+  }};
+  value = 42;
+  ec.notify_one();
+  consumer.join();
+  CAF_CHECK_EQUAL(ec.num_waiters(), 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
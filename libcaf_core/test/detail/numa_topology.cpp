@@ -0,0 +1,59 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.numa_topology
+
+#include "caf/detail/numa_topology.hpp"
+
+#include "caf/test/dsl.hpp"
+
+using namespace caf;
+
+namespace {
+
+using cpu_list = std::vector<int>;
+
+optional<cpu_list> parse(string_view str) {
+  return detail::parse_cpu_list(str);
+}
+
+} // namespace
+
+CAF_TEST(CPU lists consist of single CPUs and ranges) {
+  CAF_CHECK_EQUAL(parse(""), cpu_list{});
+  CAF_CHECK_EQUAL(parse("3"), cpu_list({3}));
+  CAF_CHECK_EQUAL(parse("0-3"), cpu_list({0, 1, 2, 3}));
+  CAF_CHECK_EQUAL(parse("0-1,8,10-11"), cpu_list({0, 1, 8, 10, 11}));
+  CAF_CHECK_EQUAL(parse("4,0-1\n"), cpu_list({0, 1, 4}));
+  CAF_CHECK_EQUAL(parse("1,1-2"), cpu_list({1, 2}));
+}
+
+CAF_TEST(malformed CPU lists produce none) {
+  CAF_CHECK_EQUAL(parse("-1"), none);
+  CAF_CHECK_EQUAL(parse("1-"), none);
+  CAF_CHECK_EQUAL(parse("3-1"), none);
+  CAF_CHECK_EQUAL(parse("1,"), none);
+  CAF_CHECK_EQUAL(parse("1,,2"), none);
+  CAF_CHECK_EQUAL(parse("a"), none);
+}
+
+CAF_TEST(topologies map CPUs to their NUMA node) {
+  std::vector<detail::numa_topology::node> nodes;
+  nodes.emplace_back(detail::numa_topology::node{0, {0, 1, 4, 5}});
+  nodes.emplace_back(detail::numa_topology::node{1, {2, 3, 6, 7}});
+  detail::numa_topology uut{std::move(nodes)};
+  CAF_CHECK_EQUAL(uut.cpus(), cpu_list({0, 1, 4, 5, 2, 3, 6, 7}));
+  CAF_CHECK_EQUAL(uut.node_of(0), size_t{0});
+  CAF_CHECK_EQUAL(uut.node_of(5), size_t{0});
+  CAF_CHECK_EQUAL(uut.node_of(2), size_t{1});
+  CAF_CHECK_EQUAL(uut.node_of(7), size_t{1});
+  CAF_CHECK_EQUAL(uut.node_of(8), none);
+}
+
+CAF_TEST(loading the topology of this machine always succeeds) {
+  auto uut = detail::numa_topology::load();
+  CAF_REQUIRE(!uut.nodes().empty());
+  for (auto cpu : uut.cpus())
+    CAF_CHECK(uut.node_of(cpu));
+}
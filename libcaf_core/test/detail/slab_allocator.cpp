@@ -0,0 +1,111 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.slab_allocator
+
+#include "caf/detail/slab_allocator.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace caf;
+
+using detail::slab_allocator;
+
+namespace {
+
+constexpr size_t block_size = 64;
+
+constexpr size_t num_blocks = 100;
+
+std::vector<void*> allocate_blocks() {
+  std::vector<void*> result;
+  for (size_t i = 0; i < num_blocks; ++i)
+    result.emplace_back(slab_allocator::allocate(block_size));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void deallocate_blocks(const std::vector<void*>& blocks) {
+  for (auto ptr : blocks)
+    slab_allocator::deallocate(ptr, block_size);
+}
+
+size_t system_allocations() {
+  return slab_allocator::stats().system_allocations;
+}
+
+} // namespace
+
+CAF_TEST(requests map to the smallest fitting size class) {
+  CAF_CHECK_EQUAL(slab_allocator::size_class(1), 0u);
+  CAF_CHECK_EQUAL(slab_allocator::size_class(32), 0u);
+  CAF_CHECK_EQUAL(slab_allocator::size_class(33), 1u);
+  CAF_CHECK_EQUAL(slab_allocator::size_class(128), 2u);
+  CAF_CHECK_EQUAL(slab_allocator::size_class(256), 3u);
+  CAF_CHECK_EQUAL(slab_allocator::block_size(3),
+                  slab_allocator::max_block_size);
+}
+
+CAF_TEST(blocks are aligned and do not overlap) {
+  std::vector<std::pair<char*, size_t>> blocks;
+  for (size_t size = 1; size <= slab_allocator::max_block_size; size += 7) {
+    auto ptr = static_cast<char*>(slab_allocator::allocate(size));
+    CAF_REQUIRE(ptr != nullptr);
+    CAF_CHECK_EQUAL(reinterpret_cast<uintptr_t>(ptr) % alignof(max_align_t),
+                    0u);
+    auto overlaps = [ptr, size](const auto& x) {
+      return ptr < x.first + x.second && x.first < ptr + size;
+    };
+    CAF_CHECK(std::none_of(blocks.begin(), blocks.end(), overlaps));
+    blocks.emplace_back(ptr, size);
+  }
+  for (auto [ptr, size] : blocks)
+    slab_allocator::deallocate(ptr, size);
+}
+
+CAF_TEST(the allocator reuses released blocks) {
+  auto ptr = slab_allocator::allocate(block_size);
+  slab_allocator::deallocate(ptr, block_size);
+  auto before = system_allocations();
+  CAF_CHECK_EQUAL(slab_allocator::allocate(block_size), ptr);
+  CAF_CHECK_EQUAL(system_allocations(), before);
+  slab_allocator::deallocate(ptr, block_size);
+}
+
+CAF_TEST(large requests go to the system allocator) {
+  auto before = system_allocations();
+  auto ptr = slab_allocator::allocate(slab_allocator::max_block_size + 1);
+  CAF_REQUIRE(ptr != nullptr);
+  CAF_CHECK_EQUAL(system_allocations(), before + 1);
+  slab_allocator::deallocate(ptr, slab_allocator::max_block_size + 1);
+}
+
+CAF_TEST(blocks released by other threads return to their owner) {
+  auto blocks = allocate_blocks();
+  std::thread{[&blocks] { deallocate_blocks(blocks); }}.join();
+  auto before = system_allocations();
+  CAF_CHECK_EQUAL(allocate_blocks(), blocks);
+  CAF_CHECK_EQUAL(system_allocations(), before);
+  deallocate_blocks(blocks);
+}
+
+CAF_TEST(threads adopt the blocks of exited threads) {
+  std::vector<void*> blocks;
+  std::thread{[&blocks] { blocks = allocate_blocks(); }}.join();
+  deallocate_blocks(blocks);
+  auto before = system_allocations();
+  std::vector<void*> reallocated;
+  std::thread{[&reallocated] {
+    reallocated = allocate_blocks();
+    deallocate_blocks(reallocated);
+  }}.join();
+  CAF_CHECK_EQUAL(reallocated, blocks);
+  CAF_CHECK_EQUAL(system_allocations(), before);
+}
@@ -0,0 +1,92 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE detail.work_stealing_queue
+
+#include "caf/detail/work_stealing_queue.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <numeric>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  fixture() : xs(6) {
+    std::iota(xs.begin(), xs.end(), 0);
+  }
+
+  std::vector<int> xs;
+
+  detail::work_stealing_queue<int> queue;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(work_stealing_queue_tests, fixture)
+
+CAF_TEST(a default constructed queue is empty) {
+  CAF_CHECK(queue.empty());
+  CAF_CHECK_EQUAL(queue.take_head(), nullptr);
+  CAF_CHECK_EQUAL(queue.take_tail(), nullptr);
+}
+
+CAF_TEST(the owner takes appended elements in FIFO order) {
+  for (auto& x : xs)
+    queue.append(&x);
+  CAF_CHECK_EQUAL(queue.size(), 6u);
+  for (auto& x : xs)
+    CAF_CHECK_EQUAL(queue.take_head(), &x);
+  CAF_CHECK_EQUAL(queue.take_head(), nullptr);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(prepended elements run before appended elements) {
+  queue.append(&xs[0]);
+  queue.append(&xs[1]);
+  queue.prepend(&xs[2]);
+  queue.prepend(&xs[3]);
+  CAF_CHECK_EQUAL(queue.take_head(), &xs[3]);
+  CAF_CHECK_EQUAL(queue.take_head(), &xs[2]);
+  CAF_CHECK_EQUAL(queue.take_head(), &xs[0]);
+  CAF_CHECK_EQUAL(queue.take_head(), &xs[1]);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(thieves take from the deque before the injection buffer) {
+  queue.prepend(&xs[0]);
+  queue.prepend(&xs[1]);
+  queue.append(&xs[2]);
+  CAF_CHECK_EQUAL(queue.take_tail(), &xs[0]);
+  CAF_CHECK_EQUAL(queue.take_tail(), &xs[1]);
+  CAF_CHECK_EQUAL(queue.take_tail(), &xs[2]);
+  CAF_CHECK_EQUAL(queue.take_tail(), nullptr);
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(thieves take up to half of the queue in one batch) {
+  std::vector<int*> buf;
+  CAF_CHECK_EQUAL(queue.take_tail_batch(10, buf), 0u);
+  for (auto& x : xs)
+    queue.prepend(&x);
+  CAF_CHECK_EQUAL(queue.take_tail_batch(10, buf), 3u);
+  CAF_CHECK_EQUAL(buf, std::vector<int*>({&xs[0], &xs[1], &xs[2]}));
+  buf.clear();
+  CAF_CHECK_EQUAL(queue.take_tail_batch(1, buf), 1u);
+  CAF_CHECK_EQUAL(buf, std::vector<int*>({&xs[3]}));
+  buf.clear();
+  queue.append(&xs[0]);
+  queue.append(&xs[1]);
+  CAF_CHECK_EQUAL(queue.take_tail_batch(10, buf), 2u);
+  CAF_CHECK_EQUAL(buf, std::vector<int*>({&xs[4], &xs[5]}));
+  buf.clear();
+  CAF_CHECK_EQUAL(queue.take_tail_batch(10, buf), 1u);
+  CAF_CHECK_EQUAL(buf, std::vector<int*>({&xs[1]}));
+  CAF_CHECK_EQUAL(queue.size(), 1u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,169 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE intrusive.drr_conflating_queue
+
+#include "caf/intrusive/drr_conflating_queue.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "caf/intrusive/singly_linked.hpp"
+
+using namespace caf;
+using namespace caf::intrusive;
+
+namespace {
+
+// Elements with the same tens digit have the same key.
+struct inode : singly_linked<inode> {
+  int value;
+  inode(int x = 0) : value(x) {
+    // nop
+  }
+};
+
+std::string to_string(const inode& x) {
+  return std::to_string(x.value);
+}
+
+struct inode_policy {
+  using mapped_type = inode;
+
+  using task_size_type = int;
+
+  using deficit_type = int;
+
+  using deleter_type = std::default_delete<mapped_type>;
+
+  using unique_pointer = std::unique_ptr<mapped_type, deleter_type>;
+
+  static inline task_size_type task_size(const mapped_type&) noexcept {
+    return 1;
+  }
+
+  size_t hash_key(const mapped_type& x) const noexcept {
+    return static_cast<size_t>(x.value / 10);
+  }
+
+  bool equal_keys(const mapped_type& x, const mapped_type& y) const noexcept {
+    return x.value / 10 == y.value / 10;
+  }
+
+  static void supersede(mapped_type& pending, mapped_type& x) noexcept {
+    std::swap(pending.value, x.value);
+  }
+};
+
+using queue_type = drr_conflating_queue<inode_policy>;
+
+struct fixture {
+  inode_policy policy;
+  queue_type queue{policy};
+
+  template <class Queue>
+  void fill(Queue&) {
+    // nop
+  }
+
+  template <class Queue, class T, class... Ts>
+  void fill(Queue& q, T x, Ts... xs) {
+    q.emplace_back(x);
+    fill(q, xs...);
+  }
+
+  // Appends `xs` in reverse order, just like fifo_inbox::fetch_more does.
+  template <class... Ts>
+  void lifo_fill(Ts... xs) {
+    for (auto x : {xs...})
+      queue.lifo_append(new inode(x));
+    queue.stop_lifo_append();
+  }
+
+  std::string fetch() {
+    std::string result;
+    auto f = [&](inode& x) {
+      result += to_string(x);
+      result += ' ';
+      return task_result::resume;
+    };
+    queue.new_round(1000, f);
+    if (!result.empty())
+      result.pop_back();
+    return result;
+  }
+
+  std::string drop_superseded() {
+    std::string result;
+    queue.drop_superseded([&](inode& x) {
+      result += to_string(x);
+      result += ' ';
+    });
+    if (!result.empty())
+      result.pop_back();
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(drr_conflating_queue_tests, fixture)
+
+CAF_TEST(default_constructed) {
+  CAF_REQUIRE_EQUAL(queue.empty(), true);
+  CAF_REQUIRE_EQUAL(queue.deficit(), 0);
+  CAF_REQUIRE_EQUAL(queue.total_task_size(), 0);
+  CAF_REQUIRE_EQUAL(queue.peek(), nullptr);
+  CAF_REQUIRE_EQUAL(queue.superseded(), 0u);
+}
+
+CAF_TEST(new elements replace pending elements with the same key) {
+  fill(queue, 10, 20, 11, 30, 12, 21);
+  CAF_CHECK_EQUAL(queue.total_task_size(), 3);
+  CAF_CHECK_EQUAL(queue.superseded(), 3u);
+  CAF_CHECK_EQUAL(drop_superseded(), "10 11 20");
+  CAF_CHECK_EQUAL(fetch(), "12 21 30");
+  CAF_CHECK_EQUAL(queue.empty(), true);
+  fill(queue, 13);
+  CAF_CHECK_EQUAL(fetch(), "13");
+  CAF_CHECK_EQUAL(queue.superseded(), 0u);
+}
+
+CAF_TEST(lifo_append keeps the most recent element per key) {
+  // Passing 12 first means 12 is the most recent element.
+  lifo_fill(12, 20, 11, 10);
+  CAF_CHECK_EQUAL(drop_superseded(), "11 10");
+  CAF_CHECK_EQUAL(queue.total_task_size(), 2);
+  lifo_fill(14, 13, 21);
+  CAF_CHECK_EQUAL(drop_superseded(), "12 13 20");
+  CAF_CHECK_EQUAL(fetch(), "21 14");
+}
+
+CAF_TEST(elements in use are never replaced) {
+  fill(queue, 10);
+  auto f = [&](inode& x) {
+    fill(queue, 11);
+    CAF_CHECK_EQUAL(x.value, 10);
+    return task_result::resume;
+  };
+  queue.new_round(1, f);
+  CAF_CHECK_EQUAL(queue.superseded(), 0u);
+  CAF_CHECK_EQUAL(fetch(), "11");
+}
+
+CAF_TEST(skipped elements remain replaceable) {
+  fill(queue, 10, 20);
+  auto f = [&](inode& x) {
+    return x.value < 20 ? task_result::skip : task_result::resume;
+  };
+  queue.new_round(2, f);
+  fill(queue, 11);
+  queue.flush_cache();
+  CAF_CHECK_EQUAL(drop_superseded(), "10");
+  CAF_CHECK_EQUAL(fetch(), "11");
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
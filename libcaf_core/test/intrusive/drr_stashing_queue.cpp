@@ -0,0 +1,184 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE intrusive.drr_stashing_queue
+
+#include "caf/intrusive/drr_stashing_queue.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+#include <memory>
+#include <set>
+
+#include "caf/intrusive/singly_linked.hpp"
+
+using namespace caf;
+using namespace caf::intrusive;
+
+namespace {
+
+struct inode : singly_linked<inode> {
+  int value;
+  inode(int x = 0) : value(x) {
+    // nop
+  }
+};
+
+std::string to_string(const inode& x) {
+  return std::to_string(x.value);
+}
+
+// Uses the tens digit as key. Values below 10 have no key.
+struct inode_policy {
+  using mapped_type = inode;
+
+  using task_size_type = int;
+
+  using deficit_type = int;
+
+  using deleter_type = std::default_delete<mapped_type>;
+
+  using unique_pointer = std::unique_ptr<mapped_type, deleter_type>;
+
+  using stash_key_type = int;
+
+  static inline task_size_type task_size(const mapped_type&) noexcept {
+    return 1;
+  }
+
+  int stash_key(const mapped_type& x) const noexcept {
+    return x.value / 10;
+  }
+
+  size_t stash_epoch() const noexcept {
+    return epoch;
+  }
+
+  bool retry(int key) const noexcept {
+    return accepted.count(key) > 0;
+  }
+
+  size_t epoch = 0;
+
+  std::set<int> accepted;
+};
+
+using queue_type = drr_stashing_queue<inode_policy>;
+
+struct fixture {
+  inode_policy policy;
+  queue_type queue{policy};
+  bool skip_unkeyed = false;
+
+  template <class Queue>
+  void fill(Queue&) {
+    // nop
+  }
+
+  template <class Queue, class T, class... Ts>
+  void fill(Queue& q, T x, Ts... xs) {
+    q.emplace_back(x);
+    fill(q, xs...);
+  }
+
+  // Switches to a new epoch that accepts `keys`.
+  void accept(std::set<int> keys) {
+    queue.policy().accepted = std::move(keys);
+    ++queue.policy().epoch;
+  }
+
+  std::string fetch() {
+    std::string result;
+    auto f = [&](inode& x) {
+      auto key = x.value / 10;
+      if (key == 0 ? skip_unkeyed : queue.policy().accepted.count(key) == 0)
+        return task_result::skip;
+      result += to_string(x);
+      result += ' ';
+      return task_result::resume;
+    };
+    queue.new_round(1000, f);
+    if (!result.empty())
+      result.pop_back();
+    return result;
+  }
+
+  std::string peek_all() {
+    std::string result;
+    queue.peek_all([&](const inode& x) {
+      result += to_string(x);
+      result += ' ';
+    });
+    if (!result.empty())
+      result.pop_back();
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(drr_stashing_queue_tests, fixture)
+
+CAF_TEST(default_constructed) {
+  CAF_REQUIRE_EQUAL(queue.empty(), true);
+  CAF_REQUIRE_EQUAL(queue.deficit(), 0);
+  CAF_REQUIRE_EQUAL(queue.total_task_size(), 0);
+  CAF_REQUIRE_EQUAL(queue.peek(), nullptr);
+  CAF_REQUIRE_EQUAL(queue.stashed(), 0u);
+}
+
+CAF_TEST(keyed elements wait for a new epoch that accepts their key) {
+  accept({1});
+  fill(queue, 11, 21, 12, 22, 13);
+  CAF_CHECK_EQUAL(fetch(), "11 12 13");
+  CAF_CHECK_EQUAL(queue.stashed(), 2u);
+  CAF_CHECK_EQUAL(queue.take_retried(), 0u);
+  accept({2});
+  fill(queue, 1, 14);
+  CAF_CHECK_EQUAL(fetch(), "1 21 22");
+  CAF_CHECK_EQUAL(queue.stashed(), 1u);
+  CAF_CHECK_EQUAL(queue.take_retried(), 2u);
+  CAF_CHECK_EQUAL(queue.take_retried(), 0u);
+}
+
+CAF_TEST(retried elements keep their order) {
+  fill(queue, 11, 21, 31, 12, 22, 32, 1);
+  CAF_CHECK_EQUAL(fetch(), "1");
+  CAF_CHECK_EQUAL(queue.stashed(), 6u);
+  accept({1, 2});
+  fill(queue, 2);
+  // Consuming the last element ends the round, so retried elements become
+  // available in the next round.
+  CAF_CHECK_EQUAL(fetch(), "2");
+  CAF_CHECK_EQUAL(queue.stashed(), 2u);
+  CAF_CHECK_EQUAL(peek_all(), "11 21 12 22");
+  CAF_CHECK_EQUAL(fetch(), "11 21 12 22");
+}
+
+CAF_TEST(unkeyed elements are retried after each consumed element) {
+  skip_unkeyed = true;
+  accept({1});
+  fill(queue, 1, 2, 11);
+  CAF_CHECK_EQUAL(fetch(), "11");
+  CAF_CHECK_EQUAL(queue.take_retried(), 2u);
+  CAF_CHECK_EQUAL(queue.stashed(), 0u);
+  CAF_CHECK_EQUAL(peek_all(), "1 2");
+  skip_unkeyed = false;
+  fill(queue, 12);
+  CAF_CHECK_EQUAL(fetch(), "1 2 12");
+  CAF_CHECK_EQUAL(queue.stashed(), 0u);
+}
+
+CAF_TEST(flushing the cache restores all stashed elements in order) {
+  skip_unkeyed = true;
+  fill(queue, 11, 1, 21, 2, 12);
+  CAF_CHECK_EQUAL(fetch(), "");
+  CAF_CHECK_EQUAL(queue.total_task_size(), 0);
+  queue.flush_cache();
+  CAF_CHECK_EQUAL(queue.stashed(), 0u);
+  CAF_CHECK_EQUAL(queue.total_task_size(), 5);
+  CAF_CHECK_EQUAL(peek_all(), "11 1 21 2 12");
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
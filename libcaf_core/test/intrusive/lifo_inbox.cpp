@@ -107,6 +107,21 @@ CAF_TEST(unblock) {
   CAF_REQUIRE_EQUAL(close_and_fetch(), "21");
 }
 
+CAF_TEST(push_front_chain) {
+  fill(inbox, 1);
+  auto x = new inode(2);
+  auto y = new inode(3);
+  y->next = x;
+  auto res = inbox.push_front_chain(y, x);
+  CAF_CHECK_EQUAL(res, inbox_result::success);
+  CAF_CHECK_EQUAL(fetch(), "321");
+  inbox.close();
+  x = new inode(4);
+  res = inbox.push_front_chain(x, x);
+  CAF_CHECK_EQUAL(res, inbox_result::queue_closed);
+  delete x;
+}
+
 CAF_TEST(await) {
   std::mutex mx;
   std::condition_variable cv;
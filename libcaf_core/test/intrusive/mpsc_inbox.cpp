@@ -0,0 +1,208 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE intrusive.mpsc_inbox
+
+#include "caf/intrusive/mpsc_inbox.hpp"
+
+#include "caf/test/unit_test.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "caf/intrusive/singly_linked.hpp"
+
+using namespace caf;
+using namespace caf::intrusive;
+
+namespace {
+
+struct inode : singly_linked<inode> {
+  int value;
+  inode(int x = 0) : value(x) {
+    // nop
+  }
+};
+
+std::string to_string(const inode& x) {
+  return std::to_string(x.value);
+}
+
+struct inode_policy {
+  using mapped_type = inode;
+
+  using task_size_type = int;
+
+  using deficit_type = int;
+
+  using deleter_type = std::default_delete<mapped_type>;
+
+  using unique_pointer = std::unique_ptr<mapped_type, deleter_type>;
+};
+
+using inbox_type = mpsc_inbox<inode_policy>;
+
+struct fixture {
+  inode_policy policy;
+  inbox_type inbox;
+
+  void fill(inbox_type&) {
+    // nop
+  }
+
+  template <class T, class... Ts>
+  void fill(inbox_type& i, T x, Ts... xs) {
+    i.emplace_back(x);
+    fill(i, xs...);
+  }
+
+  std::string fetch() {
+    std::string result;
+    auto f = [&](inode* x) {
+      result += to_string(*x);
+      delete x;
+    };
+    inbox.take_all(f);
+    return result;
+  }
+
+  std::string close_and_fetch() {
+    std::string result;
+    auto f = [&](inode* x) {
+      result += to_string(*x);
+      delete x;
+    };
+    inbox.close(f);
+    return result;
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(mpsc_inbox_tests, fixture)
+
+CAF_TEST(default_constructed) {
+  CAF_REQUIRE_EQUAL(inbox.empty(), true);
+  CAF_CHECK(inbox.pop_front() == nullptr);
+}
+
+CAF_TEST(push_back) {
+  fill(inbox, 1, 2, 3);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "123");
+  CAF_REQUIRE_EQUAL(inbox.closed(), true);
+}
+
+CAF_TEST(pop_front) {
+  fill(inbox, 1, 2, 3);
+  inode_policy::unique_pointer ptr{inbox.pop_front()};
+  CAF_REQUIRE(ptr != nullptr);
+  CAF_CHECK_EQUAL(ptr->value, 1);
+  fill(inbox, 4);
+  CAF_CHECK_EQUAL(fetch(), "234");
+  CAF_CHECK_EQUAL(inbox.empty(), true);
+  CAF_CHECK_EQUAL(fetch(), "");
+  fill(inbox, 5);
+  CAF_CHECK_EQUAL(fetch(), "5");
+}
+
+CAF_TEST(push_back_chain) {
+  fill(inbox, 1);
+  auto x = new inode(2);
+  auto y = new inode(3);
+  x->next = y;
+  auto res = inbox.push_back_chain(x, y);
+  CAF_CHECK_EQUAL(res, inbox_result::success);
+  CAF_CHECK_EQUAL(fetch(), "123");
+  x = new inode(4);
+  y = new inode(5);
+  x->next = y;
+  CAF_REQUIRE_EQUAL(inbox.try_block(), true);
+  res = inbox.push_back_chain(x, y);
+  CAF_CHECK_EQUAL(res, inbox_result::unblocked_reader);
+  CAF_CHECK_EQUAL(fetch(), "45");
+  inbox.close();
+  x = new inode(6);
+  res = inbox.push_back_chain(x, x);
+  CAF_CHECK_EQUAL(res, inbox_result::queue_closed);
+  delete x;
+}
+
+CAF_TEST(push_after_close) {
+  inbox.close();
+  auto res = inbox.push_back(new inode(0));
+  CAF_REQUIRE_EQUAL(res, inbox_result::queue_closed);
+}
+
+CAF_TEST(unblock) {
+  CAF_REQUIRE_EQUAL(inbox.try_block(), true);
+  auto res = inbox.push_back(new inode(1));
+  CAF_REQUIRE_EQUAL(res, inbox_result::unblocked_reader);
+  res = inbox.push_back(new inode(2));
+  CAF_REQUIRE_EQUAL(res, inbox_result::success);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "12");
+}
+
+CAF_TEST(fetching from a blocked inbox resets it to empty) {
+  CAF_REQUIRE_EQUAL(inbox.try_block(), true);
+  CAF_CHECK_EQUAL(fetch(), "");
+  CAF_CHECK_EQUAL(inbox.blocked(), false);
+  CAF_CHECK_EQUAL(inbox.try_block(), true);
+}
+
+CAF_TEST(await) {
+  std::mutex mx;
+  std::condition_variable cv;
+  std::thread t{[&] { inbox.synchronized_emplace_back(mx, cv, 1); }};
+  inbox.synchronized_await(mx, cv);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "1");
+  t.join();
+}
+
+CAF_TEST(timed_await) {
+  std::mutex mx;
+  std::condition_variable cv;
+  auto tout = std::chrono::system_clock::now();
+  tout += std::chrono::microseconds(1);
+  auto res = inbox.synchronized_await(mx, cv, tout);
+  CAF_REQUIRE_EQUAL(res, false);
+  fill(inbox, 1);
+  res = inbox.synchronized_await(mx, cv, tout);
+  CAF_REQUIRE_EQUAL(res, true);
+  CAF_CHECK_EQUAL(fetch(), "1");
+  tout += std::chrono::hours(1000);
+  std::thread t{[&] { inbox.synchronized_emplace_back(mx, cv, 2); }};
+  res = inbox.synchronized_await(mx, cv, tout);
+  CAF_REQUIRE_EQUAL(res, true);
+  CAF_REQUIRE_EQUAL(close_and_fetch(), "2");
+  t.join();
+}
+
+CAF_TEST(concurrent writers preserve their order) {
+  constexpr int num_writers = 4;
+  constexpr int num_values = 10'000;
+  std::vector<std::thread> writers;
+  for (int i = 0; i < num_writers; ++i)
+    writers.emplace_back([this, i] {
+      for (int j = 0; j < num_values; ++j)
+        inbox.emplace_back(i * num_values + j);
+    });
+  std::vector<int> next(num_writers, 0);
+  int received = 0;
+  auto f = [&](inode* x) {
+    inode_policy::unique_pointer guard{x};
+    auto writer = x->value / num_values;
+    CAF_CHECK_EQUAL(x->value % num_values, next[writer]);
+    ++next[writer];
+    ++received;
+  };
+  while (received < num_writers * num_values)
+    if (!inbox.take_all(f))
+      std::this_thread::yield();
+  for (auto& t : writers)
+    t.join();
+  CAF_CHECK_EQUAL(inbox.empty(), true);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
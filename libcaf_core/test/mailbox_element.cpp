@@ -97,3 +97,92 @@ CAF_TEST(downstream_msg_dynamic) {
     make_message(make<downstream_msg::close>({0, 0}, nullptr)));
   CAF_CHECK(m1->mid.category() == message_id::downstream_message_category);
 }
+
+namespace {
+
+bool stored_inline(const mailbox_element& x) {
+  auto first = reinterpret_cast<const char*>(&x);
+  auto ptr = reinterpret_cast<const char*>(x.content().cptr());
+  return ptr >= first && ptr < first + sizeof(mailbox_element);
+}
+
+bool inline_payloads_enabled() {
+  if (mailbox_element::stores_inline<int32_t, int32_t>())
+    return true;
+  CAF_MESSAGE("skip test: inline payloads are disabled or too small");
+  return false;
+}
+
+} // namespace
+
+CAF_TEST(mailbox elements store small trivial payloads inline) {
+  if (!inline_payloads_enabled())
+    return;
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2);
+  CAF_CHECK(stored_inline(*m1));
+  CAF_CHECK(m1->content().cdata().embedded());
+  CAF_CHECK_EQUAL((fetch<int, int>(*m1)), make_tuple(1, 2));
+  m1->content().get_mutable_as<int>(0) = 10;
+  CAF_CHECK(stored_inline(*m1));
+  CAF_CHECK_EQUAL((fetch<int, int>(*m1)), make_tuple(10, 2));
+}
+
+CAF_TEST(mailbox elements store large or non trivial payloads on the heap) {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages,
+                                 string{"hello"});
+  CAF_CHECK(!stored_inline(*m1));
+  CAF_CHECK(!m1->content().cdata().embedded());
+  CAF_CHECK((!mailbox_element::stores_inline<int32_t, int32_t, int32_t,
+                                             int32_t, int32_t, int32_t>()));
+  auto m2 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2,
+                                 3, 4, 5, 6);
+  CAF_CHECK(!stored_inline(*m2));
+}
+
+CAF_TEST(copying inline payloads copies them to the heap) {
+  if (!inline_payloads_enabled())
+    return;
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2);
+  auto msg = m1->content();
+  CAF_CHECK(!msg.cdata().embedded());
+  CAF_CHECK(msg.cptr() != m1->content().cptr());
+  CAF_CHECK(stored_inline(*m1));
+  m1.reset();
+  CAF_CHECK_EQUAL((fetch<int, int>(msg)), make_tuple(1, 2));
+  message copy;
+  copy = msg;
+  CAF_CHECK(copy.cptr() == msg.cptr());
+}
+
+CAF_TEST(moving inline payloads moves them to the heap) {
+  if (!inline_payloads_enabled())
+    return;
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), no_stages, 1, 2);
+  auto msg = std::move(m1->payload);
+  CAF_CHECK(!msg.cdata().embedded());
+  CAF_CHECK(m1->payload.empty());
+  m1.reset();
+  CAF_CHECK_EQUAL((fetch<int, int>(msg)), make_tuple(1, 2));
+  auto m2 = make_mailbox_element(nullptr, make_message_id(), no_stages, 3, 4);
+  message other;
+  other.swap(m2->payload);
+  CAF_CHECK(!other.cdata().embedded());
+  CAF_CHECK(m2->payload.empty());
+  m2.reset();
+  CAF_CHECK_EQUAL((fetch<int, int>(other)), make_tuple(3, 4));
+}
+
+CAF_TEST(actors receive inline payloads) {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto adder = sys.spawn([] {
+    return behavior{
+      [](int32_t x, int32_t y) { return x + y; },
+    };
+  });
+  scoped_actor self{sys};
+  self->request(adder, infinite, 20, 22)
+    .receive([](int32_t result) { CAF_CHECK_EQUAL(result, 42); },
+             [](const error& err) { CAF_FAIL("request failed: " << err); });
+  self->send_exit(adder, exit_reason::user_shutdown);
+}
@@ -0,0 +1,137 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE mailbox_overflow_policy
+
+#include "caf/mailbox_overflow_policy.hpp"
+
+#include "core-test.hpp"
+
+#include <vector>
+
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/telemetry/counter.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct fixture : test_coordinator_fixture<> {
+  // Spawns an actor that stores all received integers in `received`.
+  actor spawn_collector(size_t capacity, mailbox_overflow_policy policy) {
+    return sys.spawn_bounded(capacity, policy,
+                             [this](event_based_actor*) -> behavior {
+                               return {
+                                 [this](int32_t x) {
+                                   received.emplace_back(x);
+                                   return x;
+                                 },
+                               };
+                             });
+  }
+
+  int64_t overflows(string_view policy) {
+    auto family = sys.base_metrics().mailbox_overflows;
+    return family->get_or_add({{"policy", policy}})->value();
+  }
+
+  std::vector<int32_t> received;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(mailbox_overflow_policy_tests, fixture)
+
+CAF_TEST(actors spawn with unbounded mailboxes by default) {
+  auto aut = sys.spawn([](event_based_actor*) -> behavior {
+    return {
+      [](int32_t) {},
+    };
+  });
+  CAF_CHECK_EQUAL(deref<local_actor>(aut).mailbox_capacity(), 0u);
+  for (int32_t i = 0; i < 10; ++i)
+    self->send(aut, i);
+  CAF_CHECK_EQUAL(deref<local_actor>(aut).bounded_mailbox_size(), 0u);
+}
+
+CAF_TEST(drop_newest discards messages that exceed the capacity) {
+  auto aut = spawn_collector(2, mailbox_overflow_policy::drop_newest);
+  run();
+  for (int32_t i = 1; i <= 4; ++i)
+    self->send(aut, i);
+  CAF_CHECK_EQUAL(deref<local_actor>(aut).bounded_mailbox_size(), 2u);
+  run();
+  CAF_CHECK_EQUAL(received, std::vector<int32_t>({1, 2}));
+  CAF_CHECK_EQUAL(deref<local_actor>(aut).bounded_mailbox_size(), 0u);
+  CAF_CHECK_EQUAL(overflows("drop-newest"), 2);
+  CAF_MESSAGE("the actor accepts new messages after draining its mailbox");
+  self->send(aut, 5);
+  run();
+  CAF_CHECK_EQUAL(received, std::vector<int32_t>({1, 2, 5}));
+}
+
+CAF_TEST(drop_oldest discards the oldest messages in the mailbox) {
+  auto aut = spawn_collector(2, mailbox_overflow_policy::drop_oldest);
+  run();
+  for (int32_t i = 1; i <= 4; ++i)
+    self->send(aut, i);
+  run();
+  CAF_CHECK_EQUAL(received, std::vector<int32_t>({3, 4}));
+  CAF_CHECK_EQUAL(deref<local_actor>(aut).bounded_mailbox_size(), 0u);
+  CAF_CHECK_EQUAL(overflows("drop-oldest"), 2);
+}
+
+CAF_TEST(reject responds to requests with mailbox_full) {
+  auto aut = spawn_collector(2, mailbox_overflow_policy::reject);
+  run();
+  auto r1 = self->request(aut, infinite, int32_t{1});
+  auto r2 = self->request(aut, infinite, int32_t{2});
+  auto r3 = self->request(aut, infinite, int32_t{3});
+  CAF_CHECK_EQUAL(overflows("reject"), 1);
+  r3.receive([](int32_t) { CAF_FAIL("mailbox accepted too many messages"); },
+             [](error& err) { CAF_CHECK_EQUAL(err, sec::mailbox_full); });
+  run();
+  r1.receive([](int32_t x) { CAF_CHECK_EQUAL(x, 1); },
+             [](error& err) { CAF_FAIL("request failed: " << err); });
+  r2.receive([](int32_t x) { CAF_CHECK_EQUAL(x, 2); },
+             [](error& err) { CAF_FAIL("request failed: " << err); });
+  CAF_CHECK_EQUAL(received, std::vector<int32_t>({1, 2}));
+}
+
+CAF_TEST(system messages bypass the capacity) {
+  auto aut = spawn_collector(1, mailbox_overflow_policy::drop_newest);
+  run();
+  self->monitor(aut);
+  self->send(aut, 1);
+  self->send(aut, 2);
+  self->send_exit(aut, exit_reason::user_shutdown);
+  CAF_CHECK_EQUAL(overflows("drop-newest"), 1);
+  run();
+  CAF_CHECK_EQUAL(received, std::vector<int32_t>({1}));
+  expect((int32_t), from(aut).to(self).with(1));
+  expect((down_msg), from(aut).to(self).with(_));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(block suspends blocking senders until the mailbox has room) {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto aut = sys.spawn_bounded(1, mailbox_overflow_policy::block,
+                               [](event_based_actor*) -> behavior {
+                                 auto sum = std::make_shared<int32_t>(0);
+                                 return {
+                                   [sum](int32_t x) { *sum += x; },
+                                   [sum](get_atom) { return *sum; },
+                                 };
+                               });
+  scoped_actor self{sys};
+  for (int32_t i = 1; i <= 100; ++i)
+    self->send(aut, i);
+  self->request(aut, infinite, get_atom_v)
+    .receive([](int32_t sum) { CAF_CHECK_EQUAL(sum, 5050); },
+             [](const error& err) { CAF_FAIL("request failed: " << err); });
+  anon_send_exit(aut, exit_reason::user_shutdown);
+}
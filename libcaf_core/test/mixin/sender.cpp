@@ -9,6 +9,8 @@
 #include "caf/test/dsl.hpp"
 
 #include <chrono>
+#include <string>
+#include <vector>
 
 using namespace caf;
 
@@ -89,4 +91,27 @@ CAF_TEST(anonymous messages receive no response) {
   disallow((std::string), from(testee).to(self).with(hello));
 }
 
+CAF_TEST(batches arrive in order and schedule the receiver once) {
+  std::vector<std::string> xs{"a", "b", "c"};
+  run();
+  self->send_batch(testee, xs);
+  CAF_CHECK_EQUAL(sched.jobs.size(), 1u);
+  for (const auto& x : xs)
+    expect((std::string), from(self).to(testee).with(x));
+  for (const auto& x : xs)
+    expect((std::string), from(testee).to(self).with(x));
+  self->make_batch(testee).add(hello).add(1, 2).send();
+  expect((std::string), from(self).to(testee).with(hello));
+  expect((int, int), from(self).to(testee).with(1, 2));
+}
+
+CAF_TEST(batches to terminated actors count as rejected messages) {
+  auto dead = sys.spawn([] { return behavior{[](int) {}}; });
+  anon_send_exit(dead, exit_reason::kill);
+  run();
+  auto before = sys.base_metrics().rejected_messages->value();
+  self->send_batch(dead, std::vector<int>{1, 2, 3});
+  CAF_CHECK_EQUAL(sys.base_metrics().rejected_messages->value(), before + 3);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -118,6 +118,8 @@ using umsg_id = uint_constant<scheduled_actor::upstream_queue_index>;
 
 using dmsg_id = uint_constant<scheduled_actor::downstream_queue_index>;
 
+using cmsg_id = uint_constant<scheduled_actor::conflating_queue_index>;
+
 // -- entity and mailbox visitor -----------------------------------------------
 
 class entity : public scheduled_actor {
@@ -146,7 +148,7 @@ public:
 
   entity(actor_config& cfg, const char* cstr_name, time_point* global_time)
     : super(cfg),
-      mbox(unit, unit, unit, unit, unit),
+      mbox(unit, unit, unit, unit, unit, unit),
       name_(cstr_name),
       global_time_(global_time) {
     CAF_ASSERT(global_time_ != nullptr);
@@ -374,6 +376,12 @@ struct msg_visitor {
     return intrusive::task_result::resume;
   }
 
+  result_type operator()(cmsg_id, entity::conflating_queue&,
+                         mailbox_element&) {
+    CAF_FAIL("unexpected function call");
+    return intrusive::task_result::stop;
+  }
+
   result_type operator()(umsg_id, entity::upstream_queue&, mailbox_element& x) {
     CAF_REQUIRE(x.content().match_elements<upstream_msg>());
     self->current_mailbox_element(&x);
@@ -0,0 +1,145 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE scheduled_actor
+
+#include "caf/scheduled_actor.hpp"
+
+#include "core-test.hpp"
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_execution_unit.hpp"
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct fixture : test_coordinator_fixture<> {
+  fixture() : context(&sys) {
+    // nop
+  }
+
+  // Spawns an actor that spends 2ms on each message.
+  actor spawn_sleeper(timespan slice) {
+    return sys.spawn([this, slice](event_based_actor* self) -> behavior {
+      if (slice.count() != 0)
+        self->set_max_time_slice(slice);
+      return {
+        [this](int32_t) {
+          std::this_thread::sleep_for(2ms);
+          ++processed;
+        },
+      };
+    });
+  }
+
+  // Resumes `hdl` with unlimited throughput.
+  resumable::resume_result resume(const actor& hdl) {
+    auto max_throughput = std::numeric_limits<size_t>::max();
+    return deref<scheduled_actor>(hdl).resume(&context, max_throughput);
+  }
+
+  scoped_execution_unit context;
+
+  size_t processed = 0;
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(scheduled_actor_tests, fixture)
+
+CAF_TEST(time slices are disabled by default) {
+  auto aut = spawn_sleeper(timespan{0});
+  CAF_CHECK(is_infinite(deref<scheduled_actor>(aut).max_time_slice()));
+  for (int32_t i = 0; i < 3; ++i)
+    self->send(aut, i);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(processed, 3u);
+}
+
+CAF_TEST(actors yield their worker after using up their time slice) {
+  auto aut = spawn_sleeper(1ms);
+  for (int32_t i = 0; i < 3; ++i)
+    self->send(aut, i);
+  CAF_CHECK_EQUAL(resume(aut), resumable::resume_later);
+  CAF_CHECK_EQUAL(processed, 1u);
+  CAF_CHECK_EQUAL(resume(aut), resumable::resume_later);
+  CAF_CHECK_EQUAL(processed, 2u);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(processed, 3u);
+}
+
+CAF_TEST(actors with urgent messages ask for scheduling with high priority) {
+  auto aut = spawn_sleeper(timespan{0});
+  auto& ref = deref<scheduled_actor>(aut);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(ref.priority(), message_priority::normal);
+  self->send<message_priority::high>(aut, int32_t{1});
+  CAF_CHECK_EQUAL(ref.priority(), message_priority::high);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  self->send(aut, int32_t{2});
+  CAF_CHECK_EQUAL(ref.priority(), message_priority::normal);
+}
+
+CAF_TEST(conflating actors only process the latest message per key) {
+  std::vector<int32_t> values;
+  auto aut = sys.spawn([&values](event_based_actor* self) -> behavior {
+    // Integers with the same tens digit have the same key.
+    self->conflate<int32_t>([](int32_t x) { return x / 10; });
+    return {
+      [&values](int32_t x) { values.push_back(x); },
+      [&values](const std::string&) { values.push_back(-1); },
+    };
+  });
+  for (auto x : {11, 12, 21, 13, 22})
+    self->send(aut, int32_t{x});
+  self->send(aut, "hello"s);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(values, std::vector<int32_t>({-1, 13, 22}));
+  values.clear();
+  self->send(aut, int32_t{14});
+  self->request(aut, infinite, int32_t{15});
+  self->request(aut, infinite, int32_t{16});
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(values, std::vector<int32_t>({15, 16, 14}));
+}
+
+CAF_TEST(actors only retry skipped messages that a new behavior accepts) {
+  std::vector<std::string> log;
+  auto aut = sys.spawn([&log](event_based_actor* self) -> behavior {
+    self->set_default_handler(skip);
+    return {
+      [=, &log](int32_t x) {
+        log.emplace_back(std::to_string(x));
+        self->become([&log](const std::string& x) { log.emplace_back(x); });
+      },
+    };
+  });
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  auto& queue = deref<scheduled_actor>(aut).get_normal_queue();
+  self->send(aut, "a"s);
+  self->send(aut, 1.0);
+  self->send(aut, "b"s);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(queue.stashed(), 3u);
+  queue.take_retried();
+  self->send(aut, int32_t{1});
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(log, std::vector<std::string>({"1", "a", "b"}));
+  CAF_CHECK_EQUAL(queue.stashed(), 1u);
+  CAF_CHECK_EQUAL(queue.take_retried(), 2u);
+  self->send(aut, "c"s);
+  CAF_CHECK_EQUAL(resume(aut), resumable::awaiting_message);
+  CAF_CHECK_EQUAL(log.back(), "c");
+  CAF_CHECK_EQUAL(queue.take_retried(), 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,99 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE scheduler.abstract_coordinator
+
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+#include "core-test.hpp"
+
+#include <sstream>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr const char* config_text = R"__(
+caf {
+  scheduler {
+    max-threads = 1
+    domains {
+      io {
+        max-threads = 2
+        max-throughput = 10
+      }
+    }
+  }
+}
+)__";
+
+struct config : actor_system_config {
+  config() {
+    std::istringstream conf{config_text};
+    if (auto err = parse(string_list{}, conf))
+      CAF_FAIL("parse() failed: " << err);
+  }
+};
+
+struct fixture {
+  config cfg;
+  actor_system sys;
+  scoped_actor self;
+
+  fixture() : sys(cfg), self(sys) {
+    // nop
+  }
+
+  // Returns the scheduler domain of the worker that ran `hdl`.
+  scheduler::abstract_coordinator* domain_of_worker(const actor& hdl) {
+    using ptr = scheduler::abstract_coordinator*;
+    ptr result = nullptr;
+    self->request(hdl, infinite, get_atom_v)
+      .receive([&](uint64_t addr) { result = reinterpret_cast<ptr>(addr); },
+               [&](const error& err) { CAF_FAIL("request failed: " << err); });
+    return result;
+  }
+};
+
+behavior reporter(event_based_actor* self) {
+  return {
+    [self](get_atom) {
+      return static_cast<uint64_t>(
+        reinterpret_cast<uintptr_t>(self->context()->scheduler_domain()));
+    },
+  };
+}
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(scheduler_domain_tests, fixture)
+
+CAF_TEST(the actor system creates one scheduler per configured domain) {
+  CAF_CHECK(!sys.scheduler().is_scheduler_domain());
+  CAF_CHECK_EQUAL(sys.scheduler().num_workers(), 1u);
+  auto io = sys.scheduler_domain("io");
+  CAF_REQUIRE(io != nullptr);
+  CAF_CHECK(io->is_scheduler_domain());
+  CAF_CHECK_EQUAL(io->domain_name(), "io");
+  CAF_CHECK_EQUAL(io->num_workers(), 2u);
+  CAF_CHECK_EQUAL(io->max_throughput(), 10u);
+  CAF_CHECK(sys.scheduler_domain("gpu") == nullptr);
+}
+
+CAF_TEST(actors run on the workers of their scheduler domain) {
+  auto io = sys.scheduler_domain("io");
+  CAF_REQUIRE(io != nullptr);
+  CAF_CHECK_EQUAL(domain_of_worker(sys.spawn(reporter)), nullptr);
+  CAF_CHECK_EQUAL(domain_of_worker(sys.spawn_in_domain("io", reporter)), io);
+  CAF_MESSAGE("unknown domains fall back to the default scheduler");
+  CAF_CHECK_EQUAL(domain_of_worker(sys.spawn_in_domain("gpu", reporter)),
+                  nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,104 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#define CAF_SUITE scheduler.sampling_profiler
+
+#include "caf/scheduler/sampling_profiler.hpp"
+
+#include "core-test.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+#include "caf/scoped_actor.hpp"
+
+using namespace caf;
+
+using sampling_profiler = scheduler::sampling_profiler;
+
+namespace {
+
+constexpr const char* file_name = "sampling-profiler-test.bin";
+
+sampling_profiler::sample make_sample(actor_id id) {
+  sampling_profiler::sample result;
+  result.worker = 0;
+  result.messages = 1;
+  result.id = id;
+  result.start = 0;
+  result.duration = 1000;
+  result.name[0] = '\0';
+  return result;
+}
+
+struct fixture {
+  ~fixture() {
+    std::remove(file_name);
+  }
+};
+
+} // namespace
+
+CAF_TEST_FIXTURE_SCOPE(sampling_profiler_tests, fixture)
+
+CAF_TEST(ring buffers drop samples when full) {
+  sampling_profiler::ring_buffer buf{3};
+  CAF_CHECK_EQUAL(buf.capacity(), 4u);
+  for (actor_id id = 1; id <= 4; ++id)
+    CAF_CHECK(buf.push(make_sample(id)));
+  CAF_CHECK(!buf.push(make_sample(5)));
+  std::vector<actor_id> ids;
+  auto collect = [&ids](const sampling_profiler::sample& x) {
+    ids.emplace_back(x.id);
+  };
+  CAF_CHECK_EQUAL(buf.drain(collect), 4u);
+  CAF_CHECK_EQUAL(ids, std::vector<actor_id>({1, 2, 3, 4}));
+  CAF_CHECK(buf.push(make_sample(6)));
+  CAF_CHECK_EQUAL(buf.drain(collect), 1u);
+  CAF_CHECK_EQUAL(ids.back(), 6u);
+}
+
+CAF_TEST(the profiler writes samples of all actors) {
+  {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.scheduler.enable-profiling", true);
+    cfg.set("caf.scheduler.profiling-output-file", file_name);
+    cfg.set("caf.scheduler.profiling-sample-rate", 1);
+    actor_system sys{cfg};
+    CAF_REQUIRE(sys.scheduler().profiler() != nullptr);
+    auto testee = sys.spawn([](event_based_actor*) -> behavior {
+      return {
+        [](int32_t x) { return x; },
+      };
+    });
+    scoped_actor self{sys};
+    for (int32_t i = 0; i < 10; ++i)
+      self->request(testee, infinite, i)
+        .receive([](int32_t) {},
+                 [](const error& err) { CAF_FAIL("request failed: " << err); });
+    self->send_exit(testee, exit_reason::user_shutdown);
+  }
+  std::ifstream in{file_name, std::ios::binary};
+  std::ostringstream out;
+  CAF_CHECK_EQUAL(sampling_profiler::convert_to_trace_events(in, out), none);
+  auto json = out.str();
+  CAF_CHECK(json.compare(0, 16, R"({"traceEvents":[)") == 0);
+  CAF_CHECK(json.find(R"("name":"user.scheduled-actor")") != std::string::npos);
+  CAF_CHECK(json.find(R"("messages":1)") != std::string::npos);
+}
+
+CAF_TEST(the converter rejects unknown input) {
+  std::istringstream in{"foobar"};
+  std::ostringstream out;
+  CAF_CHECK_NOT_EQUAL(sampling_profiler::convert_to_trace_events(in, out),
+                      none);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
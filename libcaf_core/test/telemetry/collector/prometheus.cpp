@@ -72,4 +72,24 @@ some_request_duration_seconds_count{x="get"} 3 42000
   CAF_CHECK_EQUAL(res1, exporter.collect_from(registry));
 }
 
+CAF_TEST(the Prometheus collector optionally ranks mailbox sizes) {
+  auto mbox = registry.gauge_family("caf.actor", "mailbox-size", {"name"},
+                                    "Number of messages in the mailbox.");
+  mbox->get_or_add({{"name", "foo"}})->value(3);
+  mbox->get_or_add({{"name", "bar"}})->value(7);
+  mbox->get_or_add({{"name", "baz"}})->value(5);
+  exporter.hottest_mailboxes(2);
+  CAF_CHECK_EQUAL(exporter.collect_from(registry, 42),
+                  R"(# HELP caf_actor_mailbox_size Number of messages in the mailbox.
+# TYPE caf_actor_mailbox_size gauge
+caf_actor_mailbox_size{name="foo"} 3 42000
+caf_actor_mailbox_size{name="bar"} 7 42000
+caf_actor_mailbox_size{name="baz"} 5 42000
+# HELP caf_actor_hottest_mailboxes Actors with the most messages in their mailbox.
+# TYPE caf_actor_hottest_mailboxes gauge
+caf_actor_hottest_mailboxes{name="bar",rank="1"} 7 42000
+caf_actor_hottest_mailboxes{name="baz",rank="2"} 5 42000
+)"_sv);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -210,3 +210,52 @@ CAF_TEST(enabling actor metrics per config creates metric instances) {
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.spawn-server"})");
   CHECK_CONTAINS(R"(caf.actor.mailbox-size{name="caf.system.config-server"})");
 }
+
+namespace {
+
+// Counts the observations of caf.actor.mailbox-time.
+struct mailbox_time_collector {
+  int64_t observations = 0;
+
+  template <class T>
+  void operator()(const metric_family*, const metric*, const T*) {
+    // nop
+  }
+
+  template <class T>
+  void operator()(const metric_family* family, const metric*,
+                  const histogram<T>* wrapped) {
+    if (family->prefix() == "caf.actor" && family->name() == "mailbox-time")
+      for (const auto& bucket : wrapped->buckets())
+        observations += bucket.count.value();
+  }
+};
+
+} // namespace
+
+CAF_TEST(actors only timestamp sampled messages) {
+  actor_system_config cfg;
+  test_coordinator_fixture<>::init_config(cfg);
+  put(cfg.content, "caf.metrics-filters.actors.includes",
+      std::vector<std::string>{"user.*"});
+  put(cfg.content, "caf.metrics-filters.actors.sample-rate", 4);
+  actor_system sys{cfg};
+  auto& sched = dynamic_cast<scheduler::test_coordinator&>(sys.scheduler());
+  auto aut = sys.spawn([](event_based_actor*) -> behavior {
+    return {
+      [](int) {
+        // nop
+      },
+    };
+  });
+  for (int i = 0; i < 8; ++i)
+    anon_send(aut, i);
+  sched.run();
+  mailbox_time_collector collector;
+  sys.metrics().collect(collector);
+  CAF_CHECK_EQUAL(collector.observations, 2);
+  test_collector sizes;
+  sys.metrics().collect(sizes);
+  auto entry = R"(caf.actor.mailbox-size{name="user.scheduled-actor"} 0)";
+  CAF_CHECK_NOT_EQUAL(sizes.result.find(entry), std::string::npos);
+}
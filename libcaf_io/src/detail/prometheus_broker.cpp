@@ -4,6 +4,7 @@
 
 #include "caf/detail/prometheus_broker.hpp"
 
+#include "caf/actor_system_config.hpp"
 #include "caf/span.hpp"
 #include "caf/string_algorithms.hpp"
 #include "caf/string_view.hpp"
@@ -174,6 +175,9 @@ constexpr string_view request_ok = "HTTP/1.1 200 OK\r\n"
 } // namespace
 
 prometheus_broker::prometheus_broker(actor_config& cfg) : io::broker(cfg) {
+  collector_.hottest_mailboxes(get_or(
+    system().config(), "caf.middleman.prometheus-http.hottest-mailboxes",
+    size_t{0}));
 #ifdef HAS_PROCESS_METRICS
   using telemetry::dbl_gauge;
   using telemetry::int_gauge;
@@ -191,7 +191,9 @@ void middleman::add_module_options(actor_system_config& cfg) {
     .add<size_t>("workers", "number of deserialization workers");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
-    .add<std::string>("address", "bind address for the HTTP server socket");
+    .add<std::string>("address", "bind address for the HTTP server socket")
+    .add<size_t>("hottest-mailboxes",
+                 "number of actors in caf_actor_hottest_mailboxes (0 = off)");
 }
 
 actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
@@ -0,0 +1,42 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+// Converts the output of the scheduler profiler (see
+// caf.scheduler.enable-profiling) to the trace-event JSON format for loading
+// it into chrome://tracing or Perfetto.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "caf/error.hpp"
+#include "caf/init_global_meta_objects.hpp"
+#include "caf/scheduler/sampling_profiler.hpp"
+
+using caf::scheduler::sampling_profiler;
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <profiler-output> <json-output>"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  // Required for rendering errors.
+  caf::core::init_global_meta_objects();
+  std::ifstream in{argv[1], std::ios::binary};
+  if (!in) {
+    std::cerr << "*** unable to open " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ofstream out{argv[2]};
+  if (!out) {
+    std::cerr << "*** unable to open " << argv[2] << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (auto err = sampling_profiler::convert_to_trace_events(in, out)) {
+    std::cerr << "*** " << to_string(err) << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}